@@ -0,0 +1,99 @@
+/**
+ * @file busybox.hpp
+ * @brief Generates synthetic multi-tool applications ("busybox") for benchmarks.
+ *
+ * Command names are built from a fixed syllable list, so they share prefixes
+ * and vary in length like those of real multi-tools (`net-show`,
+ * `netcfg-list`, ...). Generation is deterministic for a given seed.
+ */
+
+#pragma once
+
+#include <clixxi/app.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * @struct BusyboxCommand
+ * @brief Generated command definition.
+ */
+struct BusyboxCommand {
+    std::string name;                 /**< Command name. */
+    std::string description;          /**< Command description. */
+    std::vector<std::string> options; /**< Option names. */
+};
+
+/**
+ * @brief Generates a set of unique command definitions.
+ *
+ * @param commands Number of commands.
+ * @param options Number of options per command.
+ * @param seed Generator seed.
+ * @return Commands in generation order.
+ */
+inline std::vector<BusyboxCommand> generate_busybox(std::size_t commands, std::size_t options,
+                                                    std::uint32_t seed = 1) {
+    static const char* const syllables[] = {"net", "cfg",  "show", "list", "get",  "set",  "log",
+                                            "disk", "user", "proc", "mem",  "cpu",  "init", "sync",
+                                            "dump", "load", "run",  "stat", "tar",  "zip"};
+    constexpr std::size_t syllable_count = sizeof(syllables) / sizeof(syllables[0]);
+
+    std::uint32_t state = seed ? seed : 1;
+    auto next = [&state] {  // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    std::vector<BusyboxCommand> result;
+    result.reserve(commands);
+    std::set<std::string> used;
+    while (result.size() < commands) {
+        std::string name = syllables[next() % syllable_count];
+        const std::uint32_t parts = 1 + next() % 3;
+        for (std::uint32_t i = 1; i < parts; ++i)
+            name.append(next() % 2 ? "-" : "").append(syllables[next() % syllable_count]);
+        if (!used.insert(name).second) {
+            name += std::to_string(result.size());
+            if (!used.insert(name).second)
+                continue;
+        }
+
+        BusyboxCommand command{name, "Synthetic command " + name, {}};
+        command.options.reserve(options);
+        for (std::size_t i = 0; i < options; ++i)
+            command.options.push_back(std::string(syllables[next() % syllable_count]) + "-" + std::to_string(i));
+        result.push_back(std::move(command));
+    }
+    return result;
+}
+
+/**
+ * @brief Registers generated commands with no-op handlers.
+ *
+ * @param app Application to fill.
+ * @param commands Generated commands.
+ * @param lazy Whether to use App::lazy_command() (commands must then outlive app).
+ */
+inline void register_busybox(Clixxi::App& app, const std::vector<BusyboxCommand>& commands, bool lazy = false) {
+    for (const BusyboxCommand& definition : commands) {
+        auto define = [&definition](Clixxi::Command& command) {
+            for (const std::string& option : definition.options)
+                command.option(option, "Synthetic option");
+            command.run([](const Clixxi::Context&) {});
+        };
+        if (lazy)
+            app.lazy_command(definition.name, definition.description, define);
+        else
+            define(app.command(definition.name, definition.description));
+    }
+}
+
+}  // namespace bench
@@ -0,0 +1,341 @@
+/**
+ * @file clixxi_bench.cpp
+ * @brief Microbenchmarks of the Clixxi pipeline.
+ *
+ * Usage: clixxi_bench [FILTER]
+ *
+ * Runs every benchmark whose name contains FILTER. CLIXXI_BENCH_MIN_TIME
+ * sets the minimum measured time per benchmark in seconds (default 0.2).
+ * Build with optimizations (CMAKE_BUILD_TYPE=Release) for meaningful numbers.
+ */
+
+#include "busybox.hpp"
+#include "harness.hpp"
+
+#include <clixxi/app.hpp>
+#include <clixxi/async_logger.hpp>
+#include <clixxi/static_app.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct Args
+ * @brief Owned argument vector of `--kN value` pairs.
+ */
+struct Args {
+    std::vector<std::string> storage;
+    std::vector<const char*> argv;
+
+    explicit Args(std::size_t count) {
+        storage.reserve(count);
+        for (std::size_t i = 0; storage.size() < count; ++i) {
+            storage.push_back("--k" + std::to_string(i));
+            if (storage.size() < count)
+                storage.push_back(std::to_string(i));
+        }
+        for (const std::string& arg : storage)
+            argv.push_back(arg.c_str());
+    }
+
+    int argc() const { return static_cast<int>(argv.size()); }
+};
+
+void bench_context(bench::Runner& runner) {
+    for (std::size_t count : {1, 10, 100, 1000, 10000, 100000}) {
+        const Args args(count);
+        runner.run("context/argv/" + std::to_string(count), [&] {
+            const Clixxi::Context context(args.argc(), args.argv.data());
+            bench::keep(context);
+        });
+        runner.run("context/arena/" + std::to_string(count), [&] {
+            Clixxi::Arena<4096> arena;
+            const Clixxi::Context context(args.argc(), args.argv.data(), arena.resource());
+            bench::keep(context);
+        });
+    }
+    const std::vector<std::string> strings = {"--a", "1", "--b", "2", "--name", "value", "input.txt"};
+    runner.run("context/vector/7", [&] {
+        const Clixxi::Context context(strings);
+        bench::keep(context);
+    });
+}
+
+template <typename T>
+void bench_option(bench::Runner& runner, const std::string& type, const char* value) {
+    const char* argv[] = {"--v", value};
+    const Clixxi::Context context(2, argv);
+    runner.run("get_option/" + type + "/hit", [&] { bench::keep(context.get_option<T>("v")); });
+    if constexpr (!std::is_same_v<T, bool>) {
+        const T fallback{};
+        runner.run("get_option/" + type + "/miss_default", [&] { bench::keep(context.get_option<T>("x", fallback)); });
+        runner.run("get_option/" + type + "/miss_throw", [&] {
+            try {
+                bench::keep(context.get_option<T>("x"));
+            } catch (const Clixxi::MissingRequiredOptionException& e) {
+                bench::keep(e);
+            }
+        });
+    } else {
+        runner.run("get_option/bool/miss", [&] { bench::keep(context.get_option<bool>("x")); });
+    }
+    runner.run("convert/" + type, [&] {
+        T out{};
+        bench::keep(Clixxi::convert(value, out));
+        bench::keep(out);
+    });
+}
+
+/**
+ * @brief Checks that a value converts to an exact count of T (decimal values must round, not truncate).
+ *
+ * @return false (after reporting on stderr) on a mismatch.
+ */
+template <typename T>
+bool check_conversion(const char* value, typename T::rep expected) {
+    T out{};
+    if (Clixxi::convert(value, out) && out.count() == expected)
+        return true;
+    std::fprintf(stderr, "conversion check failed: '%s' gave %lld, expected %lld\n", value,
+                 static_cast<long long>(out.count()), static_cast<long long>(expected));
+    return false;
+}
+
+/**
+ * @brief Checks that a value is rejected (non-finite or out of range).
+ *
+ * @return false (after reporting on stderr) if it converts.
+ */
+template <typename T>
+bool check_rejected(const char* value) {
+    T out{};
+    if (!Clixxi::convert(value, out))
+        return true;
+    std::fprintf(stderr, "conversion check failed: '%s' was accepted\n", value);
+    return false;
+}
+
+/**
+ * @brief Verifies the conversion examples before they are timed.
+ */
+bool check_conversions() {
+    using std::chrono::milliseconds;
+    bool ok = true;
+    ok &= check_conversion<milliseconds>("250ms", 250);
+    ok &= check_conversion<milliseconds>("1.5s", 1500);
+    ok &= check_conversion<milliseconds>("0.3s", 300);
+    ok &= check_conversion<milliseconds>("1.15s", 1150);
+    ok &= check_conversion<milliseconds>("2.3h", 8280000);
+    ok &= check_conversion<milliseconds>("-0.3s", -300);
+    ok &= check_conversion<std::chrono::seconds>("2h", 7200);
+    ok &= check_rejected<milliseconds>("nanms");
+    ok &= check_rejected<milliseconds>("9223372036854775808");
+    ok &= check_rejected<Clixxi::ByteSize>("nanKiB");
+    ok &= check_rejected<Clixxi::ByteSize>("18446744073709551616");
+    return ok;
+}
+
+void bench_options(bench::Runner& runner) {
+    bench_option<bool>(runner, "bool", "true");
+    bench_option<int>(runner, "int", "12345");
+    bench_option<std::int64_t>(runner, "int64", "-9000000000");
+    bench_option<std::uint64_t>(runner, "uint64", "18000000000");
+    bench_option<std::size_t>(runner, "size", "4096");
+    bench_option<float>(runner, "float", "2.5");
+    bench_option<double>(runner, "double", "3.14159");
+    bench_option<std::string>(runner, "string", "hello world");
+    bench_option<std::string_view>(runner, "string_view", "hello world");
+    bench_option<Clixxi::ByteSize>(runner, "bytesize", "64MiB");
+    bench_option<std::chrono::milliseconds>(runner, "duration", "250ms");
+    bench_option<std::vector<int>>(runner, "list_int", "1,2,3,4,5,6,7,8");
+
+    const char* bad[] = {"--v", "not-a-number"};
+    const Clixxi::Context context(2, bad);
+    runner.run("get_option/int/bad_throw", [&] {
+        try {
+            bench::keep(context.get_option<int>("v"));
+        } catch (const Clixxi::BadOptionTypeException& e) {
+            bench::keep(e);
+        }
+    });
+}
+
+void bench_dispatch(bench::Runner& runner) {
+    for (std::size_t count : {10, 100, 1000}) {
+        const std::vector<bench::BusyboxCommand> commands = bench::generate_busybox(count, 4);
+        Clixxi::App app("busybox");
+        bench::register_busybox(app, commands);
+        app.freeze();
+
+        const bench::BusyboxCommand& target = commands[count / 2];
+        const char* argv[] = {target.name.c_str(), "--", "input"};
+        const std::string suffix = std::to_string(count);
+        runner.run("dispatch/commands/" + suffix, [&] { app.dispatch(3, argv); });
+        runner.run("find_command/commands/" + suffix, [&] { bench::keep(app.find_command(target.name)); });
+        runner.run("complete/commands/" + suffix, [&] { bench::keep(app.complete(target.name.substr(0, 2))); });
+
+        runner.run_manual("startup/register/" + suffix, [&](bench::Runner::Timer& timer) {
+            timer.start();
+            Clixxi::App fresh("busybox");
+            bench::register_busybox(fresh, commands);
+            timer.stop();
+        });
+        runner.run_manual("startup/register_lazy/" + suffix, [&](bench::Runner::Timer& timer) {
+            timer.start();
+            Clixxi::App fresh("busybox");
+            bench::register_busybox(fresh, commands, true);
+            timer.stop();
+        });
+    }
+}
+
+namespace static_app {
+
+static constexpr char name[] = "busybox";
+static constexpr char cat[] = "cat";
+static constexpr char echo[] = "echo";
+static constexpr char grep[] = "grep";
+static constexpr char pattern[] = "pattern";
+static constexpr char count[] = "count";
+
+void noop(const Clixxi::Context& ctx) { bench::keep(ctx); }
+void search(const Clixxi::Context& ctx, const Clixxi::Schema<Clixxi::opt<pattern, std::string>,
+                                                             Clixxi::opt<count, int>>& opts) {
+    bench::keep(ctx);
+    bench::keep(opts.get<count>());
+}
+
+using App = Clixxi::StaticApp<name, nullptr, nullptr, Clixxi::cmd<cat, nullptr, noop>, Clixxi::cmd<echo, nullptr, noop>,
+                              Clixxi::cmd<grep, nullptr, search, Clixxi::opt<pattern, std::string>,
+                                          Clixxi::opt<count, int>>>;
+
+}  // namespace static_app
+
+/**
+ * @brief Verifies that StaticApp renders the same help texts as an equivalent App.
+ *
+ * @return false (after reporting on stderr) on a mismatch.
+ */
+bool check_static_help() {
+    Clixxi::App app(static_app::name);
+    app.command(static_app::cat).run(static_app::noop);
+    app.command(static_app::echo).run(static_app::noop);
+    app.command(static_app::grep)
+        .run<Clixxi::Schema<Clixxi::opt<static_app::pattern, std::string>, Clixxi::opt<static_app::count, int>>>(
+            static_app::search);
+
+    bool ok = true;
+    if (app.get_help() != static_app::App::help()) {
+        std::fprintf(stderr, "help check failed: StaticApp and App help differ\n");
+        ok = false;
+    }
+    using Grep = Clixxi::cmd<static_app::grep, nullptr, static_app::search,
+                             Clixxi::opt<static_app::pattern, std::string>, Clixxi::opt<static_app::count, int>>;
+    if (app.find_command("grep")->get_help() != Grep::help()) {
+        std::fprintf(stderr, "help check failed: StaticApp and App command help differ\n");
+        ok = false;
+    }
+    return ok;
+}
+
+void bench_static_dispatch(bench::Runner& runner) {
+    const char* plain[] = {"echo", "--", "input"};
+    runner.run("dispatch/static/3", [&] { static_app::App::dispatch(3, plain); });
+    const char* schema[] = {"grep", "--pattern", "x", "--count", "3"};
+    runner.run("dispatch/static_schema/3", [&] { static_app::App::dispatch(5, schema); });
+}
+
+void bench_help(bench::Runner& runner) {
+    for (std::size_t count : {10, 100, 1000}) {
+        const std::vector<bench::BusyboxCommand> commands = bench::generate_busybox(count, 8);
+        const std::string suffix = std::to_string(count);
+        runner.run_manual("help/app/render/" + suffix, [&](bench::Runner::Timer& timer) {
+            Clixxi::App app("busybox", "Synthetic multi-tool");
+            bench::register_busybox(app, commands);
+            timer.start();
+            bench::keep(app.get_help().size());
+            timer.stop();
+        });
+
+        Clixxi::App app("busybox", "Synthetic multi-tool");
+        bench::register_busybox(app, commands);
+        runner.run("help/app/cached/" + suffix, [&] { bench::keep(app.get_help().size()); });
+    }
+
+    const std::vector<bench::BusyboxCommand> single = bench::generate_busybox(1, 32);
+    Clixxi::App app("busybox");
+    bench::register_busybox(app, single);
+    Clixxi::Command& command = app.command(single[0].name);
+    runner.run("help/command/render/32", [&] {
+        command.option("extra", "Invalidates the cached help");
+        bench::keep(command.get_help().size());
+    });
+    runner.run("help/command/cached/32", [&] { bench::keep(command.get_help().size()); });
+}
+
+void bench_logger(bench::Runner& runner, const std::string& backend) {
+    constexpr int messages = 20000;
+    for (int threads : {1, 2, 4, 8}) {
+        const std::string name = "logger/" + backend + "/threads/" + std::to_string(threads);
+        if (!runner.enabled(name))
+            continue;
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&go, t] {
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (int i = 0; i < messages; ++i)
+                    Clixxi::Logger::info("benchmark message ", i, Clixxi::field("thread", t));
+            });
+        }
+        const bench::Clock::time_point start = bench::Clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread& worker : workers)
+            worker.join();
+        const std::chrono::duration<double> elapsed = bench::Clock::now() - start;
+        bench::Runner::report(name, elapsed.count() * 1e9 / (double(messages) * threads),
+                              static_cast<std::uint64_t>(messages) * threads);
+    }
+}
+
+void bench_loggers(bench::Runner& runner) {
+    Clixxi::Logger::set_level(Clixxi::LogLevel::Info);
+    std::FILE* null = std::fopen("/dev/null", "w");
+    if (null) {
+        Clixxi::Logger::set_logger(std::make_shared<Clixxi::JsonLogger>(null));
+        bench_logger(runner, "json");
+    }
+#ifdef CLIXXI_HAS_POSIX
+    Clixxi::Logger::set_logger(std::make_shared<Clixxi::AsyncLogger>(std::string("/dev/null")));
+    bench_logger(runner, "async");
+#endif
+    Clixxi::Logger::set_logger(std::make_shared<Clixxi::ConsoleLogger>());
+    Clixxi::Logger::set_level(Clixxi::LogLevel::Warning);
+    runner.run("logger/filtered", [] { Clixxi::Logger::info("dropped ", 42); });
+    if (null)
+        std::fclose(null);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (!check_conversions() || !check_static_help())
+        return 1;
+    bench::Runner runner(argc, argv);
+    bench_context(runner);
+    bench_options(runner);
+    bench_dispatch(runner);
+    bench_static_dispatch(runner);
+    bench_help(runner);
+    bench_loggers(runner);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file harness.hpp
+ * @brief Minimal benchmark harness for clixxi_bench (no third-party dependencies).
+ *
+ * Each benchmark is a callable that runs one operation. The harness repeats
+ * it in doubling batches until a batch lasts at least the minimum time, and
+ * reports the mean time of one operation from that batch.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Prevents the compiler from discarding a computed value.
+ */
+template <typename T>
+inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @class Runner
+ * @brief Runs and reports benchmarks whose name matches a filter.
+ */
+class Runner {
+   public:
+    /**
+     * @brief Reads the filter (first argument) and CLIXXI_BENCH_MIN_TIME (seconds).
+     */
+    Runner(int argc, char* argv[]) {
+        if (argc > 1)
+            filter_ = argv[1];
+        if (const char* min_time = std::getenv("CLIXXI_BENCH_MIN_TIME"))
+            min_time_ = std::chrono::duration<double>(std::atof(min_time));
+        std::printf("%-56s %14s %12s\n", "benchmark", "time/op", "iterations");
+    }
+
+    /** @brief Returns true if a benchmark of this name should run. */
+    bool enabled(std::string_view name) const { return name.find(filter_) != std::string_view::npos; }
+
+    /**
+     * @brief Measures fn() and prints the time per call.
+     *
+     * @param name Benchmark name.
+     * @param fn Operation to measure.
+     */
+    template <typename F>
+    void run(std::string_view name, F&& fn) {
+        if (!enabled(name))
+            return;
+        fn();  // Warm-up (caches, lazy initialization).
+        for (std::uint64_t batch = 1;; batch *= 2) {
+            const Clock::time_point start = Clock::now();
+            for (std::uint64_t i = 0; i < batch; ++i)
+                fn();
+            const std::chrono::duration<double> elapsed = Clock::now() - start;
+            if (elapsed >= min_time_ || batch >= (std::uint64_t(1) << 40)) {
+                report(name, elapsed.count() * 1e9 / static_cast<double>(batch), batch);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Measures an operation whose setup must be excluded from the timing.
+     *
+     * fn(timer) performs its setup, then calls timer.start() and timer.stop()
+     * around the measured part.
+     */
+    template <typename F>
+    void run_manual(std::string_view name, F&& fn) {
+        if (!enabled(name))
+            return;
+        Timer timer;
+        fn(timer);
+        timer = Timer();
+        std::uint64_t iterations = 0;
+        while (timer.total < min_time_) {
+            fn(timer);
+            ++iterations;
+        }
+        report(name, timer.total.count() * 1e9 / static_cast<double>(iterations), iterations);
+    }
+
+    /**
+     * @brief Prints a result measured by the caller.
+     *
+     * @param name Benchmark name.
+     * @param ns Nanoseconds per operation.
+     * @param iterations Number of measured operations.
+     */
+    static void report(std::string_view name, double ns, std::uint64_t iterations) {
+        const char* unit = "ns";
+        if (ns >= 1e6) {
+            ns /= 1e6;
+            unit = "ms";
+        } else if (ns >= 1e3) {
+            ns /= 1e3;
+            unit = "us";
+        }
+        std::printf("%-56.*s %11.2f %s %12llu\n", static_cast<int>(name.size()), name.data(), ns, unit,
+                    static_cast<unsigned long long>(iterations));
+        std::fflush(stdout);
+    }
+
+    /**
+     * @struct Timer
+     * @brief Accumulates the measured parts of run_manual() iterations.
+     */
+    struct Timer {
+        std::chrono::duration<double> total{}; /**< Accumulated measured time. */
+        Clock::time_point begin;               /**< Start of the current measured part. */
+
+        void start() { begin = Clock::now(); }
+        void stop() { total += Clock::now() - begin; }
+    };
+
+   private:
+    std::string filter_;                          /**< Substring a benchmark name must contain. */
+    std::chrono::duration<double> min_time_{0.2}; /**< Minimum measured time per benchmark. */
+};
+
+}  // namespace bench
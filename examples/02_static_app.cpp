@@ -0,0 +1,42 @@
+#include <clixxi/static_app.hpp>
+
+// Names, descriptions and the version are template arguments, so they need static storage.
+static constexpr char app_name[] = "example_static";
+static constexpr char app_desc[] = "Simple app declared at compile time by Clixxi.";
+static constexpr char app_version[] = "1.0";
+
+static constexpr char sum_name[] = "sum";
+static constexpr char sum_desc[] = "Print sum between two values (a + b).";
+static constexpr char neg_name[] = "neg";
+static constexpr char neg_desc[] = "Print the negated value.";
+
+static constexpr char a[] = "a";
+static constexpr char a_desc[] = "First value.";
+static constexpr char b[] = "b";
+static constexpr char value[] = "value";
+
+using SumOptions = Clixxi::Schema<Clixxi::opt<a, int, a_desc>, Clixxi::opt<b, int>>;
+using NegOptions = Clixxi::Schema<Clixxi::opt<value, double>>;
+
+void sum(const Clixxi::Context& ctx, const SumOptions& opts) {
+    ctx.out() << "Result: " << opts.get<a>() + opts.get<b>() << '\n';
+}
+
+void neg(const Clixxi::Context& ctx, const NegOptions& opts) { ctx.out() << -opts.get<value>() << '\n'; }
+
+using App = Clixxi::StaticApp<app_name, app_desc, app_version,
+                              Clixxi::cmd<sum_name, sum_desc, sum, Clixxi::opt<a, int, a_desc>, Clixxi::opt<b, int>>,
+                              Clixxi::cmd<neg_name, neg_desc, neg, Clixxi::opt<value, double>>>;
+
+// The help text is rendered by the compiler.
+static_assert(App::help().find("sum") != std::string_view::npos);
+
+int main(int argc, char* argv[]) {
+    try {
+        App::run(argc, argv);
+    } catch (const Clixxi::Exception& e) {
+        Clixxi::Logger::get().error(e.what());
+        return 1;
+    }
+    return 0;
+}
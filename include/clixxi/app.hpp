@@ -11,10 +11,74 @@
 #pragma once
 
 #include <clixxi/command.hpp>
+#include <clixxi/completion.hpp>
+#include <clixxi/config_file.hpp>
+#include <clixxi/executor.hpp>
+#include <clixxi/fd_stream.hpp>
+#include <clixxi/name_index.hpp>
+#include <clixxi/output.hpp>
+#include <clixxi/snapshot.hpp>
+#include <clixxi/stats.hpp>
+#include <clixxi/tokenizer.hpp>
+#include <clixxi/trace.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef CLIXXI_HAS_POSIX
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
 
 namespace Clixxi {
 
+/**
+ * @struct Invocation
+ * @brief View of a single command invocation for App::run_batch().
+ *
+ * argv[0] is the command name, the remaining entries are its arguments.
+ * The argument storage must outlive the batch call.
+ */
+struct Invocation {
+    int argc;                /**< Number of entries in argv. */
+    const char* const* argv; /**< Command name followed by its arguments. */
+};
+
+/**
+ * @enum OutputOrder
+ * @brief Ordering guarantee of App::run_parallel().
+ */
+enum class OutputOrder {
+    Unordered,  /**< Each invocation's output is written as soon as it finishes. */
+    PerCommand, /**< Invocations of one command run as a batch group, in input order. */
+    Ordered,    /**< Output is written in input order. */
+};
+
+/**
+ * @struct ParallelOptions
+ * @brief Settings for App::run_parallel().
+ */
+struct ParallelOptions {
+    std::size_t threads = 0;                  /**< Worker count (0 for hardware concurrency). */
+    OutputOrder order = OutputOrder::Ordered; /**< Ordering guarantee. */
+};
+
+/**
+ * @struct ServeOptions
+ * @brief Settings for the persistent App::serve() mode.
+ */
+struct ServeOptions {
+    std::string prompt;                /**< Prompt printed before reading a line (empty for none). */
+    std::string end_marker;            /**< Text written after each command's output (e.g. "\n" or "\0"). */
+    std::string exit_command = "exit"; /**< Line that ends the session (empty to disable). */
+};
+
 /**
  * @class App
  * @brief Represents a CLI application container.
@@ -41,19 +105,341 @@ class App {
     std::string name_;                        /**< Application name. */
     std::string desc_;                        /**< Application description. */
     std::string version_;                     /**< Application version. */
-    std::map<std::string, Command> commands_; /**< Registered commands. */
+    std::map<std::string, Command, std::less<>> commands_; /**< Registered commands. */
+    NameIndex index_;                                      /**< Frozen dispatch index over commands_. */
+    std::vector<Command*> dispatch_;                       /**< Commands in index order. */
+    mutable std::string help_;                             /**< Cached help text. */
+    mutable bool help_valid_ = false;                      /**< Whether help_ is up to date. */
 
     /**
-     * @brief Extracts CLI arguments excluding executable name.
+     * @struct ConfigSource
+     * @brief Registered configuration file, loaded on first dispatch.
+     */
+    struct ConfigSource {
+        std::string path;                 /**< File path. */
+        bool required;                    /**< Whether a missing file is an error. */
+        bool loaded;                      /**< Whether loading has been attempted. */
+        std::unique_ptr<ConfigFile> file; /**< Loaded file (null if missing). */
+    };
+
+    std::vector<ConfigSource> config_; /**< Configuration files, highest precedence first. */
+    std::string snapshot_path_;        /**< Snapshot cache path (empty if disabled). */
+#ifdef CLIXXI_HAS_POSIX
+    std::unique_ptr<ConfigSnapshot> snapshot_; /**< Loaded snapshot covering the first files. */
+#endif
+
+    /** @brief Callback receiving the timings of a dispatch. */
+    using DispatchHook = SmallFunction<void(const DispatchTimings&)>;
+
+    TraceWriter trace_;            /**< Built-in trace output. */
+    bool trace_env_read_ = false;  /**< Whether CLIXXI_TRACE has been consulted. */
+    DispatchHook before_dispatch_; /**< Called before the handler runs. */
+    DispatchHook after_dispatch_;  /**< Called after the handler and the flush. */
+
+    /** @brief Returns true if dispatches are timed (trace enabled or a hook set). */
+    bool traced() const { return trace_.format() != TraceFormat::None || before_dispatch_ || after_dispatch_; }
+
+    /**
+     * @brief Resolves, parses and executes a command, recording timings if requested.
      *
-     * @param argc Argument count.
-     * @param argv Argument vector.
-     * @return Vector of arguments starting from argv[1].
+     * @param argc Number of entries in argv.
+     * @param argv Command name followed by its arguments.
+     * @param timings Timings with start and Phase::Extract set, or nullptr.
+     */
+    void dispatch(int argc, const char* const* argv, DispatchTimings* timings) {
+        CLIXXI_STATS_SCOPE(true);
+#ifdef CLIXXI_STATS
+        const Stats stats_before = Stats::local();
+#endif
+        if (argc <= 0 || std::string_view(argv[0]) == "help") {
+            print_help();
+            return;
+        }
+
+        const std::string_view name = argv[0];
+
+        if (name == "version") {
+            Output::current().write(name_).write(" version ").write(version_).flush();
+            return;
+        }
+
+        using Clock = DispatchTimings::Clock;
+        Clock::time_point phase_start = timings ? timings->start + timings->duration[0] : Clock::time_point();
+
+        int depth;
+        Command* command = &resolve(argc, argv, depth);
+        std::string path;  // Backs timings->command until the hooks have run.
+        if (timings) {
+            path = command->path();
+            timings->command = path;
+            phase_start = timings->record(Phase::Lookup, phase_start);
+        }
+
+        Arena<4096> arena;  // Parse state of one invocation, released at once.
+        Context context(argc - depth, argv + depth, arena.resource());
+        attach_sources(*command, context);
+
+        if (!timings) {
+            command->execute(context);
+            return;
+        }
+
+        phase_start = timings->record(Phase::Context, phase_start);
+        if (before_dispatch_) {
+            CLIXXI_STATS_SCOPE(false);
+            before_dispatch_(*timings);
+        }
+        {
+            struct Activate {
+                DispatchTimings* saved;
+                ~Activate() { DispatchTimings::active() = saved; }
+            } activate{std::exchange(DispatchTimings::active(), timings)};
+            command->execute(context);
+        }
+        // The flush ran inside execute() and recorded itself; the handler is the rest.
+        const std::size_t handler = static_cast<std::size_t>(Phase::Handler);
+        timings->record(Phase::Handler, phase_start);
+        timings->duration[handler] -= timings->duration[static_cast<std::size_t>(Phase::Flush)];
+#ifdef CLIXXI_STATS
+        timings->stats = Stats::local() - stats_before;
+#endif
+
+        trace_.write(*timings);
+        if (after_dispatch_) {
+            CLIXXI_STATS_SCOPE(false);
+            after_dispatch_(*timings);
+        }
+    }
+
+    /**
+     * @brief Returns the specification of a `--clixxi-trace[=SPEC]` argument.
+     *
+     * @return SPEC ("" for the bare flag), or nullptr if arg is not the flag.
+     */
+    static const char* trace_flag(const char* arg) {
+        if (std::strncmp(arg, "--clixxi-trace", 14) != 0)
+            return nullptr;
+        if (arg[14] == '\0')
+            return arg + 14;
+        return arg[14] == '=' ? arg + 15 : nullptr;
+    }
+
+    /**
+     * @brief Writes the names of an index starting with a prefix, one per line.
+     *
+     * @param out Destination.
+     * @param idx Name index.
+     * @param prefix Name prefix.
+     * @param lead Text written before every name (for example "--").
+     */
+    static void write_candidates(Output& out, const NameIndex& idx, std::string_view prefix, std::string_view lead) {
+        auto [first, last] = idx.prefix_range(prefix);
+        for (std::size_t i = first; i < last; ++i)
+            out.write(lead).write(idx.name(i)).put('\n');
+    }
+
+    /**
+     * @brief Answers a `__complete` query with one candidate per line.
+     *
+     * The first word is completed as a command name and the words right
+     * after a command path as subcommand names; a later word starting with
+     * a dash is completed as an option of the command reached or of one of
+     * its ancestors. Anything else (option values, positional arguments,
+     * words after `--`) gets no candidates, so the shell falls back to file
+     * completion. No Context is built and no help is rendered.
+     *
+     * @param count Number of words.
+     * @param words Words after the program name; the last one is being completed.
+     */
+    void complete_words(int count, const char* const* words) {
+        Output& out = Output::current();
+        const std::string_view current = count > 0 ? words[count - 1] : "";
+        if (count <= 1) {
+            write_candidates(out, index(), current, "");
+            out.flush();
+            return;
+        }
+        Command* command = find_command(words[0]);
+        if (!command) {
+            out.flush();
+            return;
+        }
+        command->load();
+        int depth = 1;
+        for (; depth < count - 1 && command->has_subcommands(); ++depth) {
+            Command* child = command->find_subcommand(words[depth]);
+            if (!child)
+                break;
+            child->load();
+            command = child;
+        }
+        bool literal = false;  // Everything after `--` is positional.
+        for (int i = depth; i < count - 1 && !literal; ++i)
+            literal = std::strcmp(words[i], "--") == 0;
+
+        if (depth == count - 1 && command->has_subcommands() && (current.empty() || current[0] != '-')) {
+            write_candidates(out, command->subcommand_index(), current, "");
+        } else if (!literal && !current.empty() && current[0] == '-' && current.find('=') == std::string_view::npos) {
+            const std::string_view prefix = current.substr(current.size() > 1 && current[1] == '-' ? 2 : 1);
+            for (const Command* node = command; node; node = node->parent())
+                write_candidates(out, node->option_index(), prefix, "--");
+        }
+        out.flush();
+    }
+
+    /**
+     * @brief Enables the built-in trace from CLIXXI_TRACE, once, unless configured in code.
+     */
+    void read_trace_env() {
+        if (trace_env_read_)
+            return;
+        trace_env_read_ = true;
+        if (trace_.format() != TraceFormat::None)
+            return;
+        if (const char* spec = std::getenv("CLIXXI_TRACE")) {
+            std::string path;
+            const TraceFormat format = TraceWriter::parse_spec(spec, path);
+            trace_.configure(format, path);
+        }
+    }
+
+    /**
+     * @brief Returns the dispatch index, building it on first use.
+     *
+     * @return Reference to the frozen index.
      */
-    std::vector<std::string> parse_args(int argc, char* argv[]) {
-        if (argc <= 1)
-            return {};
-        return std::vector<std::string>(argv + 1, argv + argc);
+    const NameIndex& index() {
+        if (!index_.built()) {
+            std::vector<std::string_view> names;
+            names.reserve(commands_.size());
+            dispatch_.clear();
+            dispatch_.reserve(commands_.size());
+            for (auto& [name, command] : commands_) {
+                names.push_back(name);
+                dispatch_.push_back(&command);
+            }
+            index_.build(std::move(names));
+        }
+        return index_;
+    }
+
+    /**
+     * @brief Loads the configuration files that have not been loaded yet.
+     *
+     * On the first load, a valid snapshot (see config_snapshot()) replaces
+     * parsing; otherwise the files are parsed and a new snapshot is written.
+     *
+     * @throws `FileReadException` - If a required file cannot be read.
+     */
+    void load_config() {
+#ifdef CLIXXI_HAS_POSIX
+        const bool use_snapshot = !snapshot_path_.empty() && !snapshot_ && !config_.front().loaded;
+        std::uint64_t key = 0;
+        if (use_snapshot) {
+            std::vector<std::string> paths;
+            paths.reserve(config_.size());
+            for (const ConfigSource& source : config_) {
+                if (source.required && ::access(source.path.c_str(), R_OK) != 0)
+                    throw FileReadException(source.path);
+                paths.push_back(source.path);
+            }
+            key = ConfigSnapshot::source_key(paths);
+
+            auto snapshot = std::make_unique<ConfigSnapshot>();
+            if (snapshot->load(snapshot_path_, key)) {
+                for (ConfigSource& source : config_)
+                    source.loaded = true;
+                snapshot_ = std::move(snapshot);
+                return;
+            }
+        }
+#endif
+        for (ConfigSource& source : config_) {
+            if (source.loaded)
+                continue;
+            source.loaded = true;
+            try {
+                source.file = std::make_unique<ConfigFile>(source.path);
+            } catch (const FileReadException&) {
+                if (source.required)
+                    throw;
+                CLIXXI_STAT(exceptions_caught);
+            }
+        }
+#ifdef CLIXXI_HAS_POSIX
+        if (use_snapshot) {
+            OptionTable merged;
+            for (const ConfigSource& source : config_) {
+                if (!source.file)
+                    continue;
+                for (const OptionTable::Entry& entry : source.file->options())
+                    merged.emplace(entry.key, entry.value);
+            }
+            ConfigSnapshot::save(snapshot_path_, key, merged);
+        }
+#endif
+    }
+
+    /**
+     * @brief Resolves the command path at the start of an invocation, in a single pass.
+     *
+     * argv[0] is looked up in the top-level index, every following word in
+     * the index of the command reached so far, until a word is not a
+     * subcommand. Every command on the path is built if it was registered
+     * lazily, so its factory can register further subcommands.
+     *
+     * @param argc Number of entries in argv.
+     * @param argv Command path followed by the arguments.
+     * @param depth Set to the number of path words.
+     * @return Deepest command reached.
+     *
+     * @throws `CommandNotFoundException` - If the command, or a subcommand of a command without a handler, is unknown.
+     */
+    Command& resolve(int argc, const char* const* argv, int& depth) {
+        Command* command = find_command(argv[0]);
+        if (!command)
+            throw CommandNotFoundException(std::string(argv[0]));
+        command->load();
+        for (depth = 1; depth < argc && command->has_subcommands(); ++depth) {
+            Command* child = command->find_subcommand(argv[depth]);
+            if (!child) {
+                if (!command->has_handler() && argv[depth][0] != '-')
+                    throw CommandNotFoundException(command->path() + " " + argv[depth]);
+                break;
+            }
+            child->load();
+            command = child;
+        }
+        return *command;
+    }
+
+    /**
+     * @brief Layers the fallback option sources under the arguments of a Context.
+     *
+     * Precedence, highest first: arguments, environment variables bound by
+     * the command, configuration files. Each file is loaded on the first
+     * call after its registration.
+     *
+     * @param command Command the Context is built for.
+     * @param context Context of the invocation.
+     *
+     * @throws `FileReadException` - If a required file cannot be read.
+     */
+    void attach_sources(Command& command, Context& context) {
+        for (Command* node = &command; node; node = node->parent()) {
+            if (const OptionTable* environment = node->environment())
+                context.add_source(*environment);
+        }
+        if (!config_.empty() && !config_.back().loaded)
+            load_config();
+#ifdef CLIXXI_HAS_POSIX
+        if (snapshot_)
+            context.add_source(snapshot_->options());
+#endif
+        for (const ConfigSource& source : config_) {
+            if (source.file)
+                context.add_source(source.file->options());
+        }
     }
 
    public:
@@ -71,7 +457,8 @@ class App {
      * @brief Registers or retrieves a command by name.
      *
      * If the command does not exist, it is created.
-     * If it already exists, the existing instance is returned.
+     * If it already exists, the existing instance is returned
+     * (a lazily registered command is built first).
      *
      * @param name Command name.
      * @param desc Optional command description.
@@ -79,16 +466,193 @@ class App {
      */
     Command& command(const std::string& name, const std::string& desc = "") {
         auto [it, isInserted] = commands_.emplace(name, Command(name, desc));
+        if (isInserted) {
+            index_.clear();
+            help_valid_ = false;
+        }
+        it->second.load();
         return it->second;
     }
 
+    /**
+     * @brief Registers a command whose definition is built on demand.
+     *
+     * Only the name and description are stored at registration time.
+     * The factory fills in options and the handler, and is invoked only
+     * when the command is dispatched, so unused commands of a large
+     * multi-tool cost almost nothing at startup.
+     *
+     * Example:
+     * @code
+     * app.lazy_command("sum", "Print sum", [](Clixxi::Command& cmd) {
+     *     cmd.option("a").option("b").run(sum_handler);
+     * });
+     * @endcode
+     *
+     * @param name Command name.
+     * @param desc Command description (shown in application help).
+     * @param factory Callable that configures the command.
+     * @return Reference to the application (fluent API).
+     */
+    App& lazy_command(const std::string& name, const std::string& desc, std::function<void(Command&)> factory) {
+        auto [it, isInserted] = commands_.emplace(name, Command(name, desc, std::move(factory)));
+        if (isInserted) {
+            index_.clear();
+            help_valid_ = false;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Builds the command dispatch index.
+     *
+     * Called automatically on the first dispatch; calling it explicitly after
+     * registration moves the cost out of the first run. Registering a new
+     * command afterwards invalidates the index, and it is rebuilt on demand.
+     */
+    void freeze() { index(); }
+
+    /**
+     * @brief Registers a configuration file as a fallback option source.
+     *
+     * Keys from the file act as `--key value` arguments that are not given
+     * on the command line. The file is memory-mapped and parsed once, on the
+     * first dispatch (see ConfigFile for the syntax).
+     *
+     * Precedence, highest first: command-line arguments, then configuration
+     * files in the order they were registered.
+     *
+     * @param path File path.
+     * @param required Whether a missing or unreadable file is an error.
+     * @return Reference to the application (fluent API).
+     */
+    App& config_file(const std::string& path, bool required = false) {
+        config_.push_back(ConfigSource{path, required, false, nullptr});
+        return *this;
+    }
+
+    /**
+     * @brief Enables a binary snapshot cache for the configuration files.
+     *
+     * On the first dispatch, if the snapshot at path was written for the
+     * same configuration files (path, size, modification time, inode) and
+     * the same executable, it is memory-mapped instead of parsing the files.
+     * Otherwise the files are parsed and the snapshot is rewritten.
+     * Only files registered before the first dispatch are covered.
+     * Has no effect on non-POSIX systems.
+     *
+     * @param path Snapshot file path (for example in a cache directory).
+     * @return Reference to the application (fluent API).
+     */
+    App& config_snapshot(const std::string& path) {
+        snapshot_path_ = path;
+        return *this;
+    }
+
+    /**
+     * @brief Enables per-phase timing output for every dispatch.
+     *
+     * Summary prints a table to stderr after each command; Chrome writes
+     * trace events to path (view in chrome://tracing or Perfetto). The file
+     * is truncated once per process, on the first traced dispatch, and
+     * collects the events of every later dispatch of that process.
+     * Equivalent to `--clixxi-trace[=SPEC]` or CLIXXI_TRACE=SPEC, with SPEC
+     * `summary`, `chrome:PATH` or `PATH.json`.
+     *
+     * @param format Output format (TraceFormat::None to disable).
+     * @param path Trace file for TraceFormat::Chrome.
+     * @return Reference to the application (fluent API).
+     */
+    App& trace(TraceFormat format, const std::string& path = "") {
+        trace_.configure(format, path);
+        trace_env_read_ = true;
+        return *this;
+    }
+
+    /**
+     * @brief Registers a callback invoked right before a handler runs.
+     *
+     * The timings carry the lookup and Context phases of the invocation.
+     * Setting a hook enables timing of every dispatch.
+     *
+     * @param hook Callable taking const DispatchTimings&.
+     * @return Reference to the application (fluent API).
+     */
+    App& before_dispatch(DispatchHook hook) {
+        before_dispatch_ = std::move(hook);
+        return *this;
+    }
+
+    /**
+     * @brief Registers a callback invoked after a handler and its output flush.
+     *
+     * The timings are complete (see DispatchTimings::overhead()), for example
+     * to feed a metrics pipeline. Not called if the handler throws.
+     *
+     * @param hook Callable taking const DispatchTimings&.
+     * @return Reference to the application (fluent API).
+     */
+    App& after_dispatch(DispatchHook hook) {
+        after_dispatch_ = std::move(hook);
+        return *this;
+    }
+
+    /**
+     * @brief Finds a registered command by exact name in O(length of name).
+     *
+     * @param name Command name.
+     * @return Pointer to the command, or nullptr if not registered.
+     */
+    Command* find_command(std::string_view name) {
+        CLIXXI_STAT(command_lookups);
+        const std::size_t i = index().find(name);
+        return i == NameIndex::npos ? nullptr : dispatch_[i];
+    }
+
+    /**
+     * @brief Returns names of all commands starting with a prefix, in sorted order.
+     *
+     * Runs in O(length of prefix + number of results).
+     *
+     * @param prefix Command name prefix.
+     * @return Matching command names.
+     */
+    std::vector<std::string_view> complete(std::string_view prefix) {
+        const NameIndex& idx = index();
+        auto [first, last] = idx.prefix_range(prefix);
+        std::vector<std::string_view> result;
+        result.reserve(last - first);
+        for (std::size_t i = first; i < last; ++i)
+            result.push_back(idx.name(i));
+        return result;
+    }
+
+    /**
+     * @brief Returns a shell completion script for the application name.
+     *
+     * The script calls the hidden `__complete` entry point of run().
+     *
+     * @param shell Target shell.
+     * @return Script text.
+     */
+    std::string completion_script(Shell shell) const { return Clixxi::completion_script(shell, name_); }
+
     /**
      * @brief Runs the application.
      *
-     * Parses CLI arguments and dispatches execution:
+     * Parses CLI arguments in place (without copying argv) and dispatches execution:
      * - "help" prints help placeholder
      * - "version" prints application version
-     * - otherwise attempts to execute a registered command
+     * - otherwise resolves the command through the frozen dispatch index,
+     *   builds it if it was registered lazily, and executes it
+     *
+     * The hidden `__complete WORD...` entry answers shell completion queries
+     * (see completion.hpp) and `__completion [bash|zsh|fish]` prints the
+     * matching script (see completion_script()).
+     *
+     * `--clixxi-trace[=SPEC]` anywhere before `--` enables the built-in trace
+     * (see trace()) and is not passed to the command; without it, the
+     * CLIXXI_TRACE environment variable is consulted.
      *
      * @param argc Argument count.
      * @param argv Argument vector.
@@ -96,25 +660,391 @@ class App {
      * @throws `CommandNotFoundException` - If command is not registered.
      */
     void run(int argc, char* argv[]) {
-        std::vector<std::string> args = parse_args(argc, argv);
+        if (argc <= 1) {
+            print_help();
+            return;
+        }
+        if (std::strcmp(argv[1], "__complete") == 0) {
+            complete_words(argc - 2, argv + 2);
+            return;
+        }
+        if (std::strcmp(argv[1], "__completion") == 0) {
+            Shell shell = Shell::Bash;
+            if (argc > 2 && !parse_shell(argv[2], shell)) {
+                Logger::error("Unknown shell '", argv[2], "' (expected bash, zsh or fish)");
+                return;
+            }
+            Output::current().write(completion_script(shell)).flush();
+            return;
+        }
+
+        read_trace_env();
+
+        // No clock read while untraced: the extraction is timed only if tracing was
+        // already on, and a `--clixxi-trace` flag found below starts the clock after it.
+        DispatchTimings timings;
+        const bool timed = traced();
+        if (timed)
+            timings.start = DispatchTimings::Clock::now();
+
+        // `--clixxi-trace[=SPEC]` is a framework flag: remove it before the command sees it.
+        // It overrides CLIXXI_TRACE, which has been read above.
+        bool has_trace_flag = false;
+        for (int i = 1; i < argc && std::strcmp(argv[i], "--") != 0; ++i) {
+            if (const char* spec = trace_flag(argv[i])) {
+                std::string path;
+                const TraceFormat format = TraceWriter::parse_spec(spec, path);
+                trace_.configure(format, path);
+                has_trace_flag = true;
+            }
+        }
+        std::vector<const char*> filtered;
+        if (has_trace_flag) {
+            bool literal = false;
+            for (int i = 1; i < argc; ++i) {
+                literal = literal || std::strcmp(argv[i], "--") == 0;
+                if (literal || !trace_flag(argv[i]))
+                    filtered.push_back(argv[i]);
+            }
+        }
 
-        if (args.empty() || args.at(0) == "help") {
-            std::cout << get_help();
+        const int count = has_trace_flag ? static_cast<int>(filtered.size()) : argc - 1;
+        const char* const* args = has_trace_flag ? filtered.data() : argv + 1;
+        if (!traced()) {
+            dispatch(count, args, nullptr);
             return;
         }
+        if (!timed)
+            timings.start = DispatchTimings::Clock::now();
+        timings.record(Phase::Extract, timings.start);
+        dispatch(count, args, &timings);
+    }
 
-        if (args.at(0) == "version") {
-            std::cout << name_ << " version " << version_;
+    /**
+     * @brief Dispatches a single invocation without the program name.
+     *
+     * argv[0] is the command name, the remaining entries are its arguments.
+     * Used by run() and by the persistent serve() mode.
+     *
+     * @param argc Number of entries in argv.
+     * @param argv Command name followed by its arguments.
+     *
+     * @throws `CommandNotFoundException` - If command is not registered.
+     */
+    void dispatch(int argc, const char* const* argv) {
+        if (!traced()) {
+            dispatch(argc, argv, nullptr);
             return;
         }
+        DispatchTimings timings;
+        timings.start = DispatchTimings::Clock::now();
+        dispatch(argc, argv, &timings);
+    }
 
-        auto it = commands_.find(args.at(0));
+    /**
+     * @brief Executes many invocations in one call.
+     *
+     * All invocations are parsed into Contexts up front and grouped by
+     * target command. Groups run in order of their first appearance, and
+     * each group is passed to Command::execute_batch() in input order,
+     * so handlers registered with Command::run_batch() can amortize setup
+     * across the whole group.
+     *
+     * Built-in "help" and "version" invocations are dispatched individually
+     * in input order relative to the groups.
+     *
+     * @param invocations Invocations to execute.
+     *
+     * @throws `CommandNotFoundException` - If any command is not registered (before anything runs).
+     */
+    void run_batch(const std::vector<Invocation>& invocations) {
+        struct Group {
+            Command* command;                     /**< Target command (nullptr for built-ins). */
+            const Invocation* builtin;            /**< Built-in invocation. */
+            std::vector<const Context*> contexts; /**< Contexts in input order. */
+        };
 
-        if (it == commands_.end())
-            throw CommandNotFoundException(args.at(0));
+        Arena<16 * 1024> arena;  // Parse state of the whole batch, released at once.
+        ArenaVector<Context> contexts(arena.resource());
+        contexts.reserve(invocations.size());
+        std::vector<Group> groups;
+        std::unordered_map<const Command*, std::size_t> group_of;
 
-        it->second.execute(Context(std::vector<std::string>(args.begin() + 1, args.end())));
+        for (const Invocation& invocation : invocations) {
+            const std::string_view name = invocation.argc > 0 ? invocation.argv[0] : "help";
+            if (name == "help" || name == "version") {
+                groups.push_back(Group{nullptr, &invocation, {}});
+                continue;
+            }
+
+            int depth;
+            Command* command = &resolve(invocation.argc, invocation.argv, depth);
+            contexts.emplace_back(invocation.argc - depth, invocation.argv + depth, arena.resource());
+            attach_sources(*command, contexts.back());
+            auto [it, isInserted] = group_of.emplace(command, groups.size());
+            if (isInserted)
+                groups.push_back(Group{command, nullptr, {}});
+            groups[it->second].contexts.push_back(&contexts.back());
+        }
+
+        for (const Group& group : groups) {
+            if (!group.command) {
+                dispatch(group.builtin->argc, group.builtin->argv);
+                continue;
+            }
+            group.command->execute_batch(group.contexts);
+        }
+    }
+
+    /**
+     * @brief Executes independent invocations concurrently on a work-stealing pool.
+     *
+     * Like run_batch(), all invocations are parsed and resolved up front on
+     * the calling thread; lazily registered commands are built there as well,
+     * so no registration happens while workers run. Commands must not be
+     * registered from handlers during a parallel run.
+     *
+     * Output written to std::cout or Context::out() by each task is buffered
+     * per task and written whole, so output of different tasks never interleaves:
+     * - OutputOrder::Unordered - one task per invocation, output in completion order;
+     * - OutputOrder::PerCommand - one task per command group (via Command::execute_batch()),
+     *   invocations of a command run in input order;
+     * - OutputOrder::Ordered - one task per invocation, output in input order.
+     *
+     * Clixxi exceptions are logged per task. The first other exception is
+     * rethrown after all tasks have finished.
+     *
+     * @param invocations Invocations to execute.
+     * @param options Pool size and ordering guarantee.
+     *
+     * @throws `CommandNotFoundException` - If any command is not registered (before anything runs).
+     */
+    void run_parallel(const std::vector<Invocation>& invocations, const ParallelOptions& options = {}) {
+        struct Item {
+            Command* command;                     /**< Target command (nullptr for built-ins). */
+            const Invocation* invocation;         /**< Source invocation. */
+            std::vector<const Context*> contexts; /**< Contexts executed by this task. */
+            std::string output;                   /**< Captured output. */
+            bool done = false;                    /**< Set when the task has finished. */
+        };
+
+        Arena<16 * 1024> arena;  // Parse state of the whole batch, released at once.
+        ArenaVector<Context> contexts(arena.resource());
+        contexts.reserve(invocations.size());
+        std::vector<Item> items;
+        items.reserve(invocations.size());
+        std::unordered_map<const Command*, std::size_t> group_of;
+
+        for (const Invocation& invocation : invocations) {
+            const std::string_view name = invocation.argc > 0 ? invocation.argv[0] : "help";
+            if (name == "help" || name == "version") {
+                get_help();  // Render the cached help before workers may read it.
+                items.push_back(Item{nullptr, &invocation, {}, {}});
+                continue;
+            }
+
+            int depth;
+            Command* command = &resolve(invocation.argc, invocation.argv, depth);
+            contexts.emplace_back(invocation.argc - depth, invocation.argv + depth, arena.resource());
+            attach_sources(*command, contexts.back());
+            if (command->prints_help(contexts.back()))
+                command->get_help();  // Render the cached help before workers may read it.
+            if (options.order == OutputOrder::PerCommand) {
+                auto [it, isInserted] = group_of.emplace(command, items.size());
+                if (isInserted)
+                    items.push_back(Item{command, &invocation, {}, {}});
+                items[it->second].contexts.push_back(&contexts.back());
+            } else {
+                items.push_back(Item{command, &invocation, {&contexts.back()}, {}});
+            }
+        }
+
+        std::streambuf* const stdout_buffer = std::cout.rdbuf();
+        RoutedStreamBuf routed(stdout_buffer);
+        struct CoutRedirect {
+            std::streambuf* saved;
+            ~CoutRedirect() { std::cout.rdbuf(saved); }
+        } redirect{std::cout.rdbuf(&routed)};
+
+        std::mutex output_mutex;
+        std::size_t next_output = 0;
+        std::exception_ptr failure;
+
+        auto finish = [&](Item& item) {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            item.done = true;
+            if (options.order != OutputOrder::Ordered) {
+                stdout_buffer->sputn(item.output.data(), static_cast<std::streamsize>(item.output.size()));
+                std::string().swap(item.output);
+                return;
+            }
+            while (next_output < items.size() && items[next_output].done) {
+                std::string& output = items[next_output++].output;
+                stdout_buffer->sputn(output.data(), static_cast<std::streamsize>(output.size()));
+                std::string().swap(output);
+            }
+        };
+
+        {
+            WorkStealingExecutor executor(options.threads);
+            for (Item& item : items) {
+                executor.submit([&, item_ptr = &item] {
+                    Item& task = *item_ptr;
+                    RoutedStreamBuf::target() = &task.output;
+                    Output task_output(&routed, 4096);  // Small: the routed target is already a buffer.
+                    Output::installed() = &task_output;
+                    try {
+                        if (!task.command)
+                            dispatch(task.invocation->argc, task.invocation->argv);
+                        else if (options.order == OutputOrder::PerCommand)
+                            task.command->execute_batch(task.contexts);
+                        else
+                            task.command->execute(*task.contexts.front());
+                    } catch (const Exception& e) {
+                        CLIXXI_STAT(exceptions_caught);
+                        Logger::error(e.what());
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(output_mutex);
+                        if (!failure)
+                            failure = std::current_exception();
+                    }
+                    task_output.flush();
+                    Output::installed() = nullptr;
+                    RoutedStreamBuf::target() = nullptr;
+                    finish(task);
+                });
+            }
+            executor.wait();
+        }
+
+        stdout_buffer->pubsync();
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+
+    /**
+     * @brief Runs a persistent REPL over a pair of streams.
+     *
+     * Reads one command line per input line, tokenizes it with shell-like
+     * quoting (see CommandLine) and dispatches it through the registered
+     * commands. The App and any handler state stay warm between commands.
+     *
+     * Input may be pipelined: commands are executed strictly in input order,
+     * and output is flushed only when no further input is already buffered,
+     * so results of back-to-back requests are written in order and in bulk.
+     * Exceptions thrown by a command are logged and do not stop the loop.
+     * The session ends at end of input, on the exit command, or when
+     * writing to out fails.
+     *
+     * While a command runs, std::cout and Context::out() are redirected to out.
+     *
+     * @param in Input stream with command lines.
+     * @param out Output stream for command results.
+     * @param options Loop settings.
+     */
+    void serve(std::istream& in = std::cin, std::ostream& out = std::cout, const ServeOptions& options = {}) {
+        struct CoutRedirect {
+            std::streambuf* saved;
+            ~CoutRedirect() { std::cout.rdbuf(saved); }
+        } redirect{std::cout.rdbuf(out.rdbuf())};
+
+        Output session_output(out.rdbuf());
+        struct OutputInstall {
+            Output* saved;
+            ~OutputInstall() { Output::installed() = saved; }
+        } install{std::exchange(Output::installed(), &session_output)};
+
+        CommandLine command_line;
+        std::string line;
+
+        for (;;) {
+            if (!options.prompt.empty() && in.rdbuf()->in_avail() <= 0) {
+                out << options.prompt;
+                out.flush();
+            }
+            if (!std::getline(in, line))
+                break;
+
+            if (!command_line.parse(line)) {
+                Logger::error("Unterminated quote or escape in command line");
+            } else if (command_line.empty()) {
+                continue;
+            } else if (!options.exit_command.empty() && command_line.argv()[0] == options.exit_command) {
+                break;
+            } else {
+                try {
+                    dispatch(command_line.argc(), command_line.argv());
+                } catch (const Exception& e) {
+                    CLIXXI_STAT(exceptions_caught);
+                    Logger::error(e.what());
+                } catch (const std::exception& e) {
+                    Logger::error("Command failed: ", e.what());
+                } catch (...) {
+                    Logger::error("Command failed with an unknown exception");
+                }
+            }
+
+            out << options.end_marker;
+            if (in.rdbuf()->in_avail() <= 0)
+                out.flush();
+            if (!out)
+                return;  // The peer is gone (for example EPIPE on a socket): end the session.
+        }
+        out.flush();
+    }
+
+#ifdef CLIXXI_HAS_POSIX
+    /**
+     * @brief Runs serve() on a Unix domain socket.
+     *
+     * Listens on path and serves connections one after another; each
+     * connection is a serve() session that ends when the client closes it
+     * or sends the exit command. The call returns only on socket errors.
+     *
+     * @param path Filesystem path of the socket (replaced if it exists).
+     * @param options Loop settings for each connection.
+     * @return false if the socket could not be created or accept() failed.
+     */
+    bool serve_unix(const std::string& path, const ServeOptions& options = {}) {
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path))
+            return false;
+
+        // Closes a descriptor on every exit path, including exceptions thrown by serve().
+        struct Descriptor {
+            int fd;
+            ~Descriptor() {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        };
+
+        const Descriptor server{::socket(AF_UNIX, SOCK_STREAM, 0)};
+        if (server.fd < 0)
+            return false;
+
+        addr.sun_family = AF_UNIX;
+        path.copy(addr.sun_path, path.size());
+        ::unlink(path.c_str());
+
+        if (::bind(server.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(server.fd, 16) < 0)
+            return false;
+
+        for (;;) {
+            const Descriptor client{::accept(server.fd, nullptr, nullptr)};
+            if (client.fd < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            suppress_sigpipe(client.fd);
+            FdStreamBuf buffer(client.fd);
+            std::istream in(&buffer);
+            std::ostream out(&buffer);
+            serve(in, out, options);
+        }
     }
+#endif
 
     /**
      * @brief Returns application help information as a string.
@@ -126,33 +1056,45 @@ class App {
      * - hint on how to get help for a specific command;
      * - developer information.
      *
-     * @return std::string A string containing formatted help information for the application.
+     * The text is rendered once, on first use, and cached until a command is registered.
+     *
+     * @return Reference to the cached help text.
      */
-    std::string get_help() const {
-        std::ostringstream oss;
-        oss << name_;
+    const std::string& get_help() const {
+        if (!help_valid_) {
+            help_.clear();
+            help_.append(name_);
 
-        if (!desc_.empty())
-            oss << " - " << desc_ << "\n";
-        oss << "\n";
+            if (!desc_.empty())
+                help_.append(" - ").append(desc_).append("\n");
+            help_.append("\n");
 
-        oss << "Usage: " << name_ << " <COMMAND> [OPTIONS]\n\n";
-        oss << "AVAILABLE COMMANDS:\n";
+            help_.append("Usage: ").append(name_).append(" <COMMAND> [OPTIONS]\n\n");
+            help_.append("AVAILABLE COMMANDS:\n");
 
-        for (const auto& [name, command] : commands_) {
-            oss << "  " << std::left << std::setw(12) << name;
-            if (!command.get_description().empty()) {
-                oss << command.get_description();
-            } else {
-                oss << "no description";
+            for (const auto& [name, command] : commands_) {
+                help_.append("  ").append(name);
+                if (name.size() < 12)
+                    help_.append(12 - name.size(), ' ');
+                if (!command.get_description().empty()) {
+                    help_.append(command.get_description());
+                } else {
+                    help_.append("no description");
+                }
+                help_.append("\n");
             }
-            oss << "\n";
-        }
 
-        oss << "\nSee '" << name_ << " <COMMAND> --help' to read about command.\n\n";
-        oss << "This application created by Clixxi (https://github.com/asyqew/clixxi).\n";
-        return oss.str();
+            help_.append("\nSee '").append(name_).append(" <COMMAND> --help' to read about command.\n\n");
+            help_.append("This application created by Clixxi (https://github.com/asyqew/clixxi).\n");
+            help_valid_ = true;
+        }
+        return help_;
     }
+
+    /**
+     * @brief Writes the application help to the current output sink.
+     */
+    void print_help() const { Output::current().write(get_help()).flush(); }
 };
 
 }  // namespace Clixxi
\ No newline at end of file
@@ -0,0 +1,352 @@
+/**
+ * @file async_logger.hpp
+ * @brief Provides an asynchronous, buffered ILogger backend.
+ *
+ * AsyncLogger moves the cost of writing log lines off the calling thread.
+ * Producers push formatted records into a bounded lock-free MPSC ring buffer;
+ * one background thread drains it in batches and writes them with writev().
+ * Handler threads are therefore never stalled by a slow stderr pipe.
+ * Available only on POSIX systems.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+#include <clixxi/logger.hpp>
+
+#ifdef CLIXXI_HAS_POSIX
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Clixxi {
+
+/**
+ * @enum OverflowPolicy
+ * @brief Behavior of AsyncLogger when its ring buffer is full.
+ */
+enum class OverflowPolicy {
+    Drop,         /**< Discard the record silently (still counted by dropped()). */
+    Block,        /**< Wait until the background thread frees a slot. */
+    CountDropped, /**< Discard the record and report the number of dropped records in the log. */
+};
+
+/**
+ * @struct AsyncLoggerOptions
+ * @brief Settings for AsyncLogger.
+ */
+struct AsyncLoggerOptions {
+    std::size_t capacity = 4096;                            /**< Ring buffer slots (rounded up to a power of two). */
+    std::chrono::milliseconds flush_interval{10};           /**< Maximum delay before records are written. */
+    OverflowPolicy overflow = OverflowPolicy::CountDropped; /**< Behavior when the buffer is full. */
+    bool json = false;                                      /**< Write records as JSON lines. */
+};
+
+/**
+ * @class AsyncLogger
+ * @brief ILogger that writes records from a background thread.
+ *
+ * Example:
+ * @code
+ * Clixxi::Logger::set_logger(std::make_shared<Clixxi::AsyncLogger>());          // stderr
+ * Clixxi::Logger::set_logger(std::make_shared<Clixxi::AsyncLogger>("app.log")); // file
+ * @endcode
+ *
+ * Colors are used only when the destination is a terminal.
+ * The background thread sleeps while the buffer is empty and is woken by
+ * the first record queued after that. Records still buffered are written
+ * when the logger is destroyed.
+ */
+class AsyncLogger : public ILogger {
+   public:
+    /**
+     * @brief Constructs a logger writing to a file descriptor (stderr by default).
+     *
+     * @param fd Destination descriptor (not closed by the logger).
+     * @param options Buffer and flush settings.
+     */
+    explicit AsyncLogger(int fd = 2, const AsyncLoggerOptions& options = {}) : AsyncLogger(fd, false, options) {}
+
+    /**
+     * @brief Constructs a logger appending to a file.
+     *
+     * If the file cannot be opened, records are written to stderr.
+     *
+     * @param path File path (created if it does not exist).
+     * @param options Buffer and flush settings.
+     */
+    explicit AsyncLogger(const std::string& path, const AsyncLoggerOptions& options = {})
+        : AsyncLogger(::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644), true, options) {}
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    /**
+     * @brief Stops the background thread after writing all buffered records.
+     */
+    ~AsyncLogger() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        worker_.join();
+        if (owns_fd_)
+            ::close(fd_);
+    }
+
+    /**
+     * @brief Queues an error record.
+     * @param msg The error message to log.
+     */
+    void error(const std::string& msg) override { log(LogLevel::Error, msg, nullptr, 0); }
+
+    /**
+     * @brief Queues a warning record.
+     * @param msg The warning message to log.
+     */
+    void warning(const std::string& msg) override { log(LogLevel::Warning, msg, nullptr, 0); }
+
+    /**
+     * @brief Queues a leveled record, formatted as text or as a JSON line.
+     */
+    void log(LogLevel level, std::string_view msg, const LogField* fields, std::size_t count) override {
+        push([&](std::string& line) {
+            if (options_.json)
+                format_json(line, level, msg, fields, count);
+            else
+                format_text(line, level, msg, fields, count, color_);
+        });
+    }
+
+    /**
+     * @brief Writes buffered records now and waits until they are written.
+     *
+     * Returns once every record queued before the call has been handed to
+     * the destination. Must not be called by a thread that is still
+     * formatting a record of its own (e.g. from a LogField callback).
+     */
+    void flush() {
+        const std::size_t target = enqueue_.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (written_ >= target)
+            return;
+        if (flush_target_ < target)
+            flush_target_ = target;
+        wake_.notify_one();
+        flushed_.wait(lock, [&] { return written_ >= target; });
+    }
+
+    /** @brief Returns the total number of records dropped because the buffer was full. */
+    std::size_t dropped() const { return dropped_total_.load(std::memory_order_relaxed); }
+
+   private:
+    /**
+     * @struct Cell
+     * @brief Ring buffer slot (bounded MPMC queue cell, used here as MPSC).
+     */
+    struct Cell {
+        std::atomic<std::size_t> sequence{0}; /**< Slot turn counter. */
+        std::string line;                     /**< Formatted record; capacity is reused. */
+    };
+
+    AsyncLoggerOptions options_;                /**< Logger settings. */
+    int fd_;                                    /**< Destination descriptor. */
+    bool owns_fd_;                              /**< Whether fd_ is closed on destruction. */
+    bool color_;                                /**< Whether prefixes are colored. */
+    std::size_t mask_;                          /**< Capacity - 1. */
+    std::unique_ptr<Cell[]> cells_;             /**< Ring buffer storage. */
+    std::atomic<std::size_t> enqueue_{0};       /**< Next producer position. */
+    std::size_t dequeue_ = 0;                   /**< Next consumer position (background thread only). */
+    std::atomic<std::size_t> dropped_{0};       /**< Dropped records not reported yet. */
+    std::atomic<std::size_t> dropped_total_{0}; /**< Dropped records in total. */
+    std::atomic<bool> idle_{false};             /**< Whether the background thread sleeps on an empty buffer. */
+    std::mutex mutex_;                          /**< Guards the members below. */
+    std::condition_variable wake_;              /**< Wakes the background thread. */
+    std::condition_variable flushed_;           /**< Signals that written_ advanced. */
+    std::size_t written_ = 0;                   /**< Records written so far (consumer position). */
+    std::size_t flush_target_ = 0;              /**< Producer position flush() waits for. */
+    bool stop_ = false;                         /**< Set on destruction. */
+    std::thread worker_;                        /**< Background writer. */
+
+    /**
+     * @brief Common constructor.
+     */
+    AsyncLogger(int fd, bool owns_fd, const AsyncLoggerOptions& options)
+        : options_(options), fd_(fd < 0 ? 2 : fd), owns_fd_(owns_fd && fd >= 0), color_(::isatty(fd_) == 1) {
+        std::size_t capacity = 2;
+        while (capacity < options_.capacity)
+            capacity *= 2;
+        mask_ = capacity - 1;
+        cells_ = std::make_unique<Cell[]>(capacity);
+        for (std::size_t i = 0; i < capacity; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        worker_ = std::thread([this] { run(); });
+    }
+
+    /**
+     * @brief Formats a record into a free slot.
+     *
+     * @param format Callable appending the formatted record to the slot string.
+     */
+    template <typename F>
+    void push(F&& format) {
+        std::size_t pos = enqueue_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0) {
+                if (enqueue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.line.clear();
+                    format(cell.line);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    // Pairs with the fence in run(): either the worker sees the record or we see it idle.
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (idle_.load(std::memory_order_relaxed)) {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        wake_.notify_one();
+                    }
+                    return;
+                }
+            } else if (diff < 0) {
+                if (options_.overflow != OverflowPolicy::Block) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    dropped_total_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                wake_.notify_one();
+                std::this_thread::yield();
+                pos = enqueue_.load(std::memory_order_relaxed);
+            } else {
+                pos = enqueue_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** @brief Returns true if the next record is ready to be written (background thread only). */
+    bool ready() const {
+        return cells_[dequeue_ & mask_].sequence.load(std::memory_order_acquire) == dequeue_ + 1;
+    }
+
+    /**
+     * @brief Writes all ready records with as few writev() calls as possible.
+     *
+     * Slots are released only after their data has been written,
+     * since the iovec entries point into the slot strings.
+     */
+    void drain() {
+        static constexpr std::size_t max_batch = 512;
+        iovec iov[max_batch + 1];
+        std::string report;
+
+        for (;;) {
+            std::size_t count = 0;
+            const std::size_t dropped = options_.overflow == OverflowPolicy::CountDropped
+                                            ? dropped_.exchange(0, std::memory_order_relaxed)
+                                            : 0;
+            if (dropped > 0) {
+                report = "Clixxi warning: " + std::to_string(dropped) + " log records dropped\n";
+                iov[count++] = iovec{report.data(), report.size()};
+            }
+
+            std::size_t taken = 0;
+            while (taken < max_batch) {
+                Cell& cell = cells_[(dequeue_ + taken) & mask_];
+                if (cell.sequence.load(std::memory_order_acquire) != dequeue_ + taken + 1)
+                    break;
+                iov[count++] = iovec{cell.line.data(), cell.line.size()};
+                ++taken;
+            }
+
+            if (count > 0)
+                write_all(iov, count);
+
+            for (std::size_t i = 0; i < taken; ++i) {
+                Cell& cell = cells_[dequeue_ & mask_];
+                cell.sequence.store(dequeue_ + mask_ + 1, std::memory_order_release);
+                ++dequeue_;
+            }
+
+            if (taken < max_batch)
+                return;
+        }
+    }
+
+    /**
+     * @brief Writes a vector of buffers, handling partial writes.
+     */
+    void write_all(iovec* iov, std::size_t count) {
+        while (count > 0) {
+            const ssize_t n = ::writev(fd_, iov, static_cast<int>(count));
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+            auto left = static_cast<std::size_t>(n);
+            while (count > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+    }
+
+    /**
+     * @brief Background thread loop.
+     *
+     * Sleeps without a timeout while the buffer is empty. Once a record is
+     * queued, waits up to flush_interval for more before writing the batch,
+     * unless flush() or the destructor asks for it earlier.
+     */
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            if (!stop_ && flush_target_ <= written_) {
+                idle_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wake_.wait(lock, [this] { return stop_ || flush_target_ > written_ || ready(); });
+                idle_.store(false, std::memory_order_relaxed);
+                if (!stop_ && flush_target_ <= written_)
+                    wake_.wait_for(lock, options_.flush_interval);
+            }
+            const bool stopping = stop_;
+            const std::size_t target = flush_target_;
+            lock.unlock();
+            drain();
+            // A producer may still be formatting a record counted by flush().
+            while (dequeue_ < target) {
+                std::this_thread::yield();
+                drain();
+            }
+            lock.lock();
+            written_ = dequeue_;
+            flushed_.notify_all();
+            if (stopping)
+                return;
+        }
+    }
+};
+
+}  // namespace Clixxi
+
+#endif
@@ -5,15 +5,24 @@
  * A Command encapsulates:
  * - command metadata (name, description),
  * - declared options,
- * - execution handler.
+ * - execution handler,
+ * - nested subcommands, each level with its own frozen dispatch index.
  */
 
 #pragma once
 
 #include <clixxi/context.hpp>
+#include <clixxi/env.hpp>
+#include <clixxi/function.hpp>
+#include <clixxi/name_index.hpp>
+#include <clixxi/schema.hpp>
+#include <clixxi/stats.hpp>
+#include <clixxi/trace.hpp>
 #include <functional>
-#include <iomanip>
-#include <iostream>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 namespace Clixxi {
 
@@ -40,6 +49,12 @@ namespace Clixxi {
  */
 class Command {
    public:
+    /** @brief Handler type receiving a parsed Context (inline storage, see SmallFunction). */
+    using Handler = SmallFunction<void(const Context&)>;
+
+    /** @brief Handler type receiving all contexts of one batch group. */
+    using BatchHandler = SmallFunction<void(const std::vector<const Context*>&)>;
+
     /**
      * @brief Constructs a command definition.
      *
@@ -48,49 +63,395 @@ class Command {
      */
     Command(const std::string& name, const std::string& desc = "") : name_(name), desc_(desc) {}
 
+    /**
+     * @brief Constructs a lazily defined command.
+     *
+     * The factory is invoked by load() to register options and the handler.
+     *
+     * @param name Command name.
+     * @param desc Command description.
+     * @param factory Callable that configures the command.
+     */
+    Command(const std::string& name, const std::string& desc, std::function<void(Command&)> factory)
+        : name_(name), desc_(desc), factory_(std::move(factory)) {}
+
+    /**
+     * @brief Copies a command with its subcommand tree.
+     *
+     * The copied subcommands point back at the copy; the copy keeps the
+     * parent of the original.
+     */
+    Command(const Command& other)
+        : name_(other.name_),
+          desc_(other.desc_),
+          handler_(other.handler_),
+          batch_handler_(other.batch_handler_),
+          options_(other.options_),
+          factory_(other.factory_),
+          env_(other.env_),
+          help_(other.help_),
+          revision_(other.revision_),
+          help_revision_(other.help_revision_),
+          option_index_(other.option_index_),
+          subcommands_(other.subcommands_),
+          parent_(other.parent_) {
+        adopt_subcommands();
+    }
+
+    /** @brief Moves a command; its subcommands point back at the new object. */
+    Command(Command&& other)
+        : name_(std::move(other.name_)),
+          desc_(std::move(other.desc_)),
+          handler_(std::move(other.handler_)),
+          batch_handler_(std::move(other.batch_handler_)),
+          options_(std::move(other.options_)),
+          factory_(std::move(other.factory_)),
+          env_(std::move(other.env_)),
+          help_(std::move(other.help_)),
+          revision_(other.revision_),
+          help_revision_(other.help_revision_),
+          option_index_(std::move(other.option_index_)),
+          subcommands_(std::move(other.subcommands_)),
+          parent_(other.parent_) {
+        adopt_subcommands();
+    }
+
+    /** @brief Replaces the definition with a copy; parent() is kept. */
+    Command& operator=(const Command& other) {
+        if (this != &other)
+            *this = Command(other);
+        return *this;
+    }
+
+    /** @brief Replaces the definition with another one; parent() is kept. */
+    Command& operator=(Command&& other) {
+        if (this == &other)
+            return *this;
+        name_ = std::move(other.name_);
+        desc_ = std::move(other.desc_);
+        handler_ = std::move(other.handler_);
+        batch_handler_ = std::move(other.batch_handler_);
+        options_ = std::move(other.options_);
+        factory_ = std::move(other.factory_);
+        env_ = std::move(other.env_);
+        help_ = std::move(other.help_);
+        revision_ = other.revision_;
+        help_revision_ = npos;  // Rendered for the lineage of the other command.
+        option_index_ = std::move(other.option_index_);
+        subcommands_ = std::move(other.subcommands_);
+        adopt_subcommands();
+        return *this;
+    }
+
+    /**
+     * @brief Builds a lazily defined command by invoking its factory once.
+     *
+     * Does nothing for commands that are already fully defined.
+     */
+    void load() {
+        if (!factory_)
+            return;
+        auto factory = std::move(factory_);
+        factory_ = nullptr;
+        factory(*this);
+    }
+
+    /**
+     * @brief Checks whether the command definition has been built.
+     *
+     * @return false if the command was registered lazily and load() has not run yet.
+     */
+    bool is_loaded() const { return !factory_; }
+
     /**
      * @brief Registers an option for the command.
      *
+     * If env is set, the option falls back to that environment variable
+     * when it is not given on the command line (see environment()).
+     *
      * @param name Option name (without leading dashes).
      * @param desc Option description.
+     * @param env Fallback environment variable name, for example "APP_THREADS".
      * @return Reference to the current Command instance (fluent API).
      */
-    Command& option(const std::string name, const std::string desc = "") {
-        options_.emplace(name, Option(name, desc));
+    Command& option(const std::string name, const std::string desc = "", const std::string& env = "") {
+        auto [it, isInserted] = options_.emplace(name, Option(name, desc, env));
+        if (isInserted && !env.empty() && env_.bound)
+            env_.source.bind(it->second.option_env_, it->second.option_name_);
+        ++revision_;
+        if (isInserted)
+            option_index_.names.clear();
         return *this;
     }
 
+    /**
+     * @brief Returns the completion index over option names, building it on first use.
+     *
+     * The index is rebuilt after an option is added.
+     *
+     * @return Reference to the frozen index (names without leading dashes).
+     */
+    const NameIndex& option_index() const {
+        if (!option_index_.names.built()) {
+            std::vector<std::string_view> names;
+            names.reserve(options_.size());
+            for (const auto& [name, option] : options_)
+                names.push_back(name);
+            option_index_.names.build(std::move(names));
+        }
+        return option_index_.names;
+    }
+
+    /**
+     * @brief Returns names of all options starting with a prefix, in sorted order.
+     *
+     * Runs in O(length of prefix + number of results).
+     *
+     * @param prefix Option name prefix (without leading dashes).
+     * @return Matching option names.
+     */
+    std::vector<std::string_view> complete(std::string_view prefix) const {
+        const NameIndex& idx = option_index();
+        auto [first, last] = idx.prefix_range(prefix);
+        std::vector<std::string_view> result;
+        result.reserve(last - first);
+        for (std::size_t i = first; i < last; ++i)
+            result.push_back(idx.name(i));
+        return result;
+    }
+
+    /**
+     * @brief Registers a nested subcommand, or returns the existing one.
+     *
+     * Subcommands form a tree (`tool cluster node drain`): App::run()
+     * resolves the path word by word through the frozen index of each
+     * level and executes the deepest command reached. Options of ancestors
+     * are inherited by reference: their environment bindings are consulted
+     * and their help is listed, but nothing is copied into the child.
+     * A command with subcommands may have a handler of its own; without
+     * one, invoking it prints its help.
+     *
+     * Example:
+     * @code
+     * auto& cluster = app.command("cluster").option("region");
+     * cluster.subcommand("node").subcommand("drain", "Evict all pods").run(drain);
+     * // tool cluster node drain --region eu
+     * @endcode
+     *
+     * @param name Subcommand name.
+     * @param desc Subcommand description.
+     * @return Reference to the subcommand (fluent API).
+     */
+    Command& subcommand(const std::string& name, const std::string& desc = "") {
+        auto [it, isInserted] = subcommands_.children.emplace(name, nullptr);
+        if (isInserted) {
+            it->second = std::make_unique<Command>(name, desc);
+            it->second->parent_ = this;
+            subcommands_.index.names.clear();
+            ++revision_;
+        }
+        return *it->second;
+    }
+
+    /**
+     * @brief Finds a direct subcommand by exact name in O(length of name).
+     *
+     * The index over subcommands is built on first use and rebuilt after
+     * a subcommand is added.
+     *
+     * @param name Subcommand name.
+     * @return Pointer to the subcommand, or nullptr if there is none.
+     */
+    Command* find_subcommand(std::string_view name) {
+        const std::size_t i = subcommand_index().find(name);
+        return i == NameIndex::npos ? nullptr : subcommands_.index.targets[i];
+    }
+
+    /**
+     * @brief Returns the index over direct subcommand names, building it on first use.
+     *
+     * @return Reference to the frozen index.
+     */
+    const NameIndex& subcommand_index() {
+        IndexCache<Command>& index = subcommands_.index;
+        if (!index.names.built()) {
+            std::vector<std::string_view> names;
+            names.reserve(subcommands_.children.size());
+            index.targets.clear();
+            index.targets.reserve(subcommands_.children.size());
+            for (auto& [name, command] : subcommands_.children) {
+                names.push_back(name);
+                index.targets.push_back(command.get());
+            }
+            index.names.build(std::move(names));
+        }
+        return index.names;
+    }
+
+    /** @brief Returns true if the command has subcommands. */
+    bool has_subcommands() const { return !subcommands_.children.empty(); }
+
+    /** @brief Returns the parent command, or nullptr for a top-level command. */
+    Command* parent() const { return parent_; }
+
+    /**
+     * @brief Returns the names from the top-level command down to this one.
+     *
+     * @return Space-separated path, for example "cluster node drain".
+     */
+    std::string path() const {
+        std::string result = name_;
+        for (const Command* node = parent_; node; node = node->parent_)
+            result.insert(0, node->name_ + " ");
+        return result;
+    }
+
+    /**
+     * @brief Returns true if a handler or a batch handler was assigned.
+     */
+    bool has_handler() const { return handler_ || batch_handler_; }
+
+    /**
+     * @brief Returns true if execute() prints the help instead of running a handler.
+     *
+     * That is the case for `--help` and for a command without handlers that
+     * groups subcommands. Callers executing on several threads render the
+     * cached help (get_help()) up front when this returns true.
+     *
+     * @param context Parsed execution context.
+     */
+    bool prints_help(const Context& context) const {
+        return context.has_option("help") || (!has_handler() && has_subcommands());
+    }
+
+    /**
+     * @brief Returns the options resolved from bound environment variables.
+     *
+     * The environment is scanned once, in a single pass, on the first call
+     * after an environment-bound option was registered.
+     *
+     * @return Table of option values, or nullptr if no option is bound to a variable.
+     */
+    const OptionTable* environment() {
+        if (!env_.bound) {
+            for (const auto& [name, option] : options_) {
+                if (!option.option_env_.empty())
+                    env_.source.bind(option.option_env_, option.option_name_);
+            }
+            env_.bound = true;
+        }
+        return env_.source.empty() ? nullptr : &env_.source.options();
+    }
+
     /**
      * @brief Assigns an execution handler to the command.
      *
-     * The handler receives a parsed Context object.
+     * The handler receives a parsed Context object. Callables up to
+     * CLIXXI_HANDLER_CAPACITY bytes are stored inline, without allocation.
      *
      * @param handler Function to execute when command is invoked.
      * @return Reference to the current Command instance (fluent API).
      */
-    Command& run(std::function<void(const Context&)> handler) {
+    Command& run(Handler handler) {
         handler_ = std::move(handler);
         return *this;
     }
 
+    /**
+     * @brief Assigns a handler that receives options converted through a Schema.
+     *
+     * All options declared in the schema are registered on the command,
+     * and the schema is built once per execution before calling the handler.
+     *
+     * @tparam S Schema type describing the command options.
+     * @param handler Callable with signature void(const Context&, const S&).
+     * @return Reference to the current Command instance (fluent API).
+     */
+    template <typename S, typename F>
+    Command& run(F handler) {
+        S::for_each_option([this](const char* name, const char* desc) { option(name, desc ? desc : ""); });
+        handler_ = [handler = std::move(handler)](const Context& context) { handler(context, S(context)); };
+        return *this;
+    }
+
+    /**
+     * @brief Assigns a batch handler to the command.
+     *
+     * Used by App::run_batch(): all invocations of this command in a batch
+     * are passed to the handler in one call, so expensive setup (opening a
+     * database, loading a model) can be shared across them.
+     * Commands without a batch handler fall back to the regular handler.
+     *
+     * @param handler Function receiving the contexts of one batch group, in input order.
+     * @return Reference to the current Command instance (fluent API).
+     */
+    Command& run_batch(BatchHandler handler) {
+        batch_handler_ = std::move(handler);
+        return *this;
+    }
+
+    /**
+     * @brief Executes the command for a group of contexts.
+     *
+     * Contexts requesting "help" print the help message. The rest are passed
+     * to the batch handler in one call, or to the regular handler one by one
+     * if no batch handler was assigned. Output::current() is flushed when
+     * the command exits.
+     *
+     * @param contexts Parsed execution contexts.
+     *
+     * @throws `CommandHasNotHandlerException` - If no handler was assigned.
+     */
+    void execute_batch(const std::vector<const Context*>& contexts) const {
+        const FlushOnExit flush_on_exit;
+        if (!batch_handler_) {
+            for (const Context* context : contexts)
+                execute(*context);
+            return;
+        }
+
+        std::vector<const Context*> work;
+        work.reserve(contexts.size());
+        for (const Context* context : contexts) {
+            if (context->has_option("help"))
+                print_help();
+            else
+                work.push_back(context);
+        }
+        if (!work.empty()) {
+            CLIXXI_STATS_SCOPE(false);
+            batch_handler_(work);
+        }
+    }
+
     /**
      * @brief Executes the command.
      *
      * If the "help" option is present, prints a minimal help message.
-     * Otherwise invokes the registered handler.
+     * Otherwise invokes the registered handler (or the batch handler
+     * with a single context if only that one was assigned). A command
+     * without handlers that groups subcommands prints its help.
+     * Output::current() is flushed when the command exits.
      *
      * @param context Parsed execution context.
      *
-     * @throws `CommandHasNotHandlerException` - If no handler was assigned.
+     * @throws `CommandHasNotHandlerException` - If no handler was assigned and there are no subcommands.
      */
     void execute(const Context& context) const {
-        if (context.has_option("help")) {
-            std::cout << get_help() << std::endl;
+        const FlushOnExit flush_on_exit;
+        if (prints_help(context)) {
+            print_help();
             return;
         }
         if (!handler_) {
+            if (batch_handler_) {
+                CLIXXI_STATS_SCOPE(false);
+                batch_handler_({&context});
+                return;
+            }
             throw CommandHasNotHandlerException(name_);
         }
+        CLIXXI_STATS_SCOPE(false);
         handler_(context);
     }
 
@@ -99,41 +460,203 @@ class Command {
      *
      * @return std::string A string with the command description, or an empty string if no description was set.
      */
-    std::string get_description() const { return desc_; }
+    const std::string& get_description() const { return desc_; }
 
     /**
-     * @brief Returns the command description.
+     * @brief Returns the command help text.
      *
-     * @return std::string A string with the command description, or an empty string if no description was set.
+     * The text is rendered once, on first use, and cached until an option or
+     * subcommand is added to the command or an option to one of its ancestors.
+     *
+     * @return Reference to the cached help text.
+     */
+    const std::string& get_help() const {
+        const std::size_t revision = lineage_revision();
+        if (help_revision_ != revision) {
+            help_.clear();
+            help_.append("Command: ").append(name_).append("\n");
+            if (!desc_.empty()) {
+                help_.append("Description: ").append(desc_).append("\n\n");
+            }
+
+            help_.append("Usage: <PROGRAM> ").append(path());
+            if (has_subcommands())
+                help_.append(" <COMMAND>");
+            if (!options_.empty()) {
+                help_.append(" [OPTIONS]\n\n");
+                help_.append("OPTIONS:\n");
+            }
+            append_options(help_, options_);
+
+            // Only the reached node renders help; ancestors' options are read in place.
+            bool inherited = false;
+            for (const Command* node = parent_; node; node = node->parent_) {
+                if (node->options_.empty())
+                    continue;
+                if (!inherited)
+                    help_.append(options_.empty() ? "\n\n" : "\n").append("INHERITED OPTIONS:\n");
+                inherited = true;
+                append_options(help_, node->options_);
+            }
+
+            if (has_subcommands()) {
+                help_.append(options_.empty() && !inherited ? "\n\n" : "\n").append("COMMANDS:\n");
+                for (const auto& [name, command] : subcommands_.children) {
+                    help_.append("  ").append(name);
+                    if (name.size() < 12)
+                        help_.append(12 - name.size(), ' ');
+                    help_.append(!command->desc_.empty() ? command->desc_ : "No description.").append("\n");
+                }
+            }
+            help_.append("\n");
+            help_revision_ = revision;
+        }
+        return help_;
+    }
+
+    /**
+     * @brief Writes the command help to the current output sink.
+     */
+    void print_help() const { Output::current().write(get_help()).flush(); }
+
+   private:
+    /** @brief help_revision_ value of help that was never rendered. */
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Returns the sum of the revisions of this command and its ancestors.
+     *
+     * Revisions only grow, so the sum changes whenever an option is added
+     * anywhere along the parent chain, which invalidates inherited help.
+     */
+    std::size_t lineage_revision() const {
+        std::size_t sum = 0;
+        for (const Command* node = this; node; node = node->parent_)
+            sum += node->revision_;
+        return sum;
+    }
+
+    /**
+     * @struct IndexCache
+     * @brief Lazily built index over names owned by the command.
+     *
+     * The index views names stored in the command, so a copied or moved
+     * cache starts empty and is rebuilt on first use.
+     *
+     * @tparam Target Type of the objects the names resolve to.
+     */
+    template <typename Target>
+    struct IndexCache {
+        NameIndex names;              /**< Frozen index (not built while empty). */
+        std::vector<Target*> targets; /**< Objects in index order (when used). */
+
+        IndexCache() = default;
+        IndexCache(const IndexCache&) {}
+        IndexCache& operator=(const IndexCache&) {
+            names.clear();
+            targets.clear();
+            return *this;
+        }
+    };
+
+    /**
+     * @struct EnvBindings
+     * @brief Environment bindings of options_.
+     *
+     * The bindings view the option strings of the command, so a copied or
+     * moved value starts unbound and environment() binds the options of
+     * its new owner again.
      */
-    std::string get_help() const {
-        std::ostringstream oss;
+    struct EnvBindings {
+        EnvSource source;  /**< Bound variables and their resolved values. */
+        bool bound = true; /**< Whether source covers every option of the owner. */
 
-        oss << "Command: " << name_ << "\n";
-        if (!desc_.empty()) {
-            oss << "Description: " << desc_ << "\n\n";
+        EnvBindings() = default;
+        EnvBindings(const EnvBindings&) : bound(false) {}
+        EnvBindings& operator=(const EnvBindings&) {
+            source = EnvSource();
+            bound = false;
+            return *this;
         }
+    };
+
+    /**
+     * @struct Subcommands
+     * @brief Owned subcommands with their dispatch index; copies are deep.
+     */
+    struct Subcommands {
+        std::map<std::string, std::unique_ptr<Command>, std::less<>> children; /**< Subcommands by name. */
+        IndexCache<Command> index;                                             /**< Frozen index over children. */
+
+        Subcommands() = default;
+        Subcommands(Subcommands&&) = default;
+        Subcommands& operator=(Subcommands&&) = default;
 
-        oss << "Usage: <PROGRAM> " << name_;
-        if (!options_.empty()) {
-            oss << " [OPTIONS]\n\n";
-            oss << "OPTIONS:\n";
+        Subcommands(const Subcommands& other) {
+            for (const auto& [name, child] : other.children)
+                children.emplace(name, std::make_unique<Command>(*child));
         }
-        for (const auto& [name, option] : options_) {
-            oss << "  --" << std::left << std::setw(10) << name;
-            if (!option.option_desc_.empty())
-                oss << "" << option.option_desc_;
-            else
-                oss << "No description.";
-            oss << "\n";
+
+        Subcommands& operator=(const Subcommands& other) {
+            if (this != &other)
+                *this = Subcommands(other);
+            return *this;
         }
-        return oss.str();
+    };
+
+    /** @brief Points the direct subcommands back at this command. */
+    void adopt_subcommands() {
+        for (auto& [name, command] : subcommands_.children)
+            command->parent_ = this;
     }
 
-   private:
+    /**
+     * @brief Appends one help line per option.
+     *
+     * @param help Help text.
+     * @param options Options to list.
+     */
+    static void append_options(std::string& help, const std::map<std::string, Option>& options) {
+        for (const auto& [name, option] : options) {
+            help.append("  --").append(name);
+            if (name.size() < 10)
+                help.append(10 - name.size(), ' ');
+            help.append(!option.option_desc_.empty() ? option.option_desc_ : "No description.");
+            if (!option.option_env_.empty())
+                help.append(" [env: ").append(option.option_env_).append("]");
+            help.append("\n");
+        }
+    }
+
+    /**
+     * @struct FlushOnExit
+     * @brief Flushes the current output sink when a handler returns or throws.
+     *
+     * The flush is recorded as Phase::Flush while a dispatch is traced.
+     */
+    struct FlushOnExit {
+        ~FlushOnExit() {
+            using Clock = DispatchTimings::Clock;
+            DispatchTimings* timings = DispatchTimings::active();
+            const Clock::time_point start = timings ? Clock::now() : Clock::time_point();
+            Output::current().flush();
+            if (timings)
+                timings->record(Phase::Flush, start);
+        }
+    };
+
     std::string name_;                            /**< Command name. */
     std::string desc_;                            /**< Command description. */
-    std::function<void(const Context&)> handler_; /**< Execution handler. */
+    Handler handler_;                             /**< Execution handler. */
+    BatchHandler batch_handler_;                  /**< Batch execution handler. */
     std::map<std::string, Option> options_;       /**< Registered options. */
+    std::function<void(Command&)> factory_;       /**< Pending lazy definition (empty once loaded). */
+    EnvBindings env_;                             /**< Environment-variable bindings of options_. */
+    mutable std::string help_;                    /**< Cached help text. */
+    std::size_t revision_ = 0;                    /**< Incremented when options or subcommands are added. */
+    mutable std::size_t help_revision_ = npos;    /**< lineage_revision() that help_ was rendered for. */
+    mutable IndexCache<const Option> option_index_; /**< Completion index over options_ (names only). */
+    Subcommands subcommands_;                       /**< Nested subcommands. */
+    Command* parent_ = nullptr;                     /**< Parent command (nullptr at top level). */
 };
 }  // namespace Clixxi
\ No newline at end of file
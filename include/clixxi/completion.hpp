@@ -0,0 +1,109 @@
+/**
+ * @file completion.hpp
+ * @brief Generates shell completion scripts for the hidden `__complete` entry point.
+ *
+ * App::run() answers `PROGRAM __complete WORD...` (the words after the
+ * program name, the last one being completed) with one candidate per line,
+ * straight from the frozen name indexes, without building a Context. The
+ * scripts below forward the command line of the shell to it and fall back
+ * to file completion when there are no candidates (option values,
+ * positional arguments).
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace Clixxi {
+
+/**
+ * @enum Shell
+ * @brief Shells with generated completion scripts.
+ */
+enum class Shell {
+    Bash, /**< bash (complete -F). */
+    Zsh,  /**< zsh (compdef). */
+    Fish, /**< fish (complete -c). */
+};
+
+/**
+ * @brief Resolves a shell by name ("bash", "zsh" or "fish").
+ *
+ * @param name Shell name.
+ * @param shell Set to the shell on success.
+ * @return false if the name is unknown.
+ */
+inline bool parse_shell(std::string_view name, Shell& shell) {
+    if (name == "bash")
+        shell = Shell::Bash;
+    else if (name == "zsh")
+        shell = Shell::Zsh;
+    else if (name == "fish")
+        shell = Shell::Fish;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Returns a completion script for a program.
+ *
+ * Example (in ~/.bashrc):
+ * @code
+ * eval "$(myapp __completion bash)"
+ * @endcode
+ *
+ * @param shell Target shell.
+ * @param program Program name as typed in the shell.
+ * @return Script text.
+ */
+inline std::string completion_script(Shell shell, std::string_view program) {
+    // Shell function names only allow a subset of the characters of program names.
+    std::string ident(program);
+    for (char& c : ident) {
+        const bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        if (!alnum)
+            c = '_';
+    }
+    const std::string name(program);
+    const std::string function = "_clixxi_" + ident;
+
+    std::string script;
+    switch (shell) {
+        case Shell::Bash:
+            script.append(function).append("() {\n");
+            script.append("    local IFS=$'\\n'\n");
+            script.append("    COMPREPLY=($(\"").append(name);
+            script.append("\" __complete \"${COMP_WORDS[@]:1:COMP_CWORD}\" 2>/dev/null))\n");
+            script.append("}\n");
+            script.append("complete -o default -F ").append(function).append(" '").append(name).append("'\n");
+            break;
+        case Shell::Zsh:
+            script.append("#compdef ").append(name).append("\n");
+            script.append(function).append("() {\n");
+            script.append("    local -a candidates\n");
+            script.append("    candidates=(\"${(@f)$(\"").append(name);
+            script.append("\" __complete \"${(@)words[2,CURRENT]}\" 2>/dev/null)}\")\n");
+            script.append("    if [[ -n \"${candidates[1]}\" ]]; then\n");
+            script.append("        compadd -a candidates\n");
+            script.append("    else\n");
+            script.append("        _files\n");
+            script.append("    fi\n");
+            script.append("}\n");
+            script.append("compdef ").append(function).append(" '").append(name).append("'\n");
+            break;
+        case Shell::Fish:
+            script.append("function ").append(function).append("\n");
+            script.append("    set -l words (commandline -opc)\n");
+            script.append("    set -e words[1]\n");
+            script.append("    set -l current (commandline -ct)\n");
+            script.append("    '").append(name).append("' __complete $words \"$current\" 2>/dev/null\n");
+            script.append("end\n");
+            script.append("complete -c '").append(name).append("' -a '(").append(function).append(")'\n");
+            break;
+    }
+    return script;
+}
+
+}  // namespace Clixxi
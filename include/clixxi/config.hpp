@@ -0,0 +1,46 @@
+/**
+ * @file config.hpp
+ * @brief Platform detection and build-time configuration macros for Clixxi.
+ *
+ * Macros defined here may be overridden by defining them before including
+ * any Clixxi header (or on the compiler command line).
+ */
+
+#pragma once
+
+/**
+ * @def CLIXXI_HAS_POSIX
+ * @brief Defined to 1 when POSIX APIs (file descriptors, sockets, mmap) are available.
+ */
+#if !defined(CLIXXI_HAS_POSIX) && (defined(__unix__) || defined(__APPLE__))
+#define CLIXXI_HAS_POSIX 1
+#endif
+
+/**
+ * @def CLIXXI_HAS_PMR
+ * @brief Defined to 1 when the standard library provides <memory_resource>.
+ *
+ * Without it, Clixxi::Arena is a no-op and options use the global allocator.
+ */
+#if !defined(CLIXXI_HAS_PMR) && defined(__has_include)
+#if __has_include(<memory_resource>)
+#define CLIXXI_HAS_PMR 1
+#endif
+#endif
+
+/**
+ * @def CLIXXI_SIMD_AVX2
+ * @brief Defined to 1 when the byte scanners use AVX2 (likewise CLIXXI_SIMD_SSE2 and CLIXXI_SIMD_NEON).
+ *
+ * The instruction set is selected from the compiler target (for example
+ * -mavx2). Define CLIXXI_NO_SIMD to force the portable scalar code.
+ */
+#if !defined(CLIXXI_NO_SIMD) && !defined(CLIXXI_SIMD_AVX2) && !defined(CLIXXI_SIMD_SSE2) && !defined(CLIXXI_SIMD_NEON)
+#if defined(__AVX2__)
+#define CLIXXI_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLIXXI_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define CLIXXI_SIMD_NEON 1
+#endif
+#endif
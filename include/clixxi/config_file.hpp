@@ -0,0 +1,249 @@
+/**
+ * @file config_file.hpp
+ * @brief Provides a memory-mapped configuration file option source.
+ *
+ * ConfigFile maps a `key = value` file (a small TOML/INI subset) into memory
+ * and parses it in a single pass. Keys and values are string views into the
+ * mapping wherever possible, so loading a file with thousands of keys costs
+ * one mmap() and one scan. Values are layered under command-line arguments
+ * (see Context::add_source()).
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+#include <clixxi/exception.hpp>
+#include <clixxi/logger.hpp>
+#include <clixxi/option_table.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <string_view>
+
+#ifdef CLIXXI_HAS_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Clixxi {
+
+/**
+ * @class ConfigFile
+ * @brief Read-only option table loaded from a configuration file.
+ *
+ * Supported syntax:
+ * - `key = value` or `key: value` per line; whitespace around both is trimmed;
+ * - `[section]` headers, which prefix the following keys as `section.key`;
+ * - values in `"double"` (with `\"`, `\\`, `\n`, `\t` escapes) or `'single'` quotes;
+ * - `#` and `;` comments on their own line, and ` #` comments after unquoted values;
+ * - a later definition of a key replaces an earlier one.
+ *
+ * Malformed lines are reported with Logger::warning() and skipped.
+ *
+ * Example:
+ * @code
+ * # service.conf
+ * threads = 8
+ * [cache]
+ * size = 64MiB          # read as --cache.size
+ * @endcode
+ *
+ * The object is neither copyable nor movable, since its table views the mapping.
+ */
+class ConfigFile {
+   public:
+    /**
+     * @brief Maps and parses a configuration file.
+     *
+     * @param path File path.
+     *
+     * @throws `FileReadException` - If the file cannot be opened or mapped.
+     */
+    explicit ConfigFile(const std::string& path) : path_(path) {
+        map();
+        parse();
+    }
+
+    ConfigFile(const ConfigFile&) = delete;
+    ConfigFile& operator=(const ConfigFile&) = delete;
+
+    /** @brief Unmaps the file. */
+    ~ConfigFile() {
+#ifdef CLIXXI_HAS_POSIX
+        if (mapping_)
+            ::munmap(mapping_, size_);
+#endif
+    }
+
+    /** @brief Returns the parsed options. */
+    const OptionTable& options() const { return options_; }
+
+    /** @brief Returns the path the file was loaded from. */
+    const std::string& path() const { return path_; }
+
+   private:
+    std::string path_;              /**< Source path. */
+    void* mapping_ = nullptr;       /**< Mapped file contents (POSIX). */
+    std::size_t size_ = 0;          /**< Size of the contents. */
+    std::string contents_;          /**< File contents read into memory (non-POSIX). */
+    std::string_view text_;         /**< View of the contents being parsed. */
+    std::deque<std::string> owned_; /**< Section keys and unescaped values (stable addresses). */
+    OptionTable options_;           /**< Parsed options. */
+
+    /**
+     * @brief Makes the file contents available as text_.
+     */
+    void map() {
+#ifdef CLIXXI_HAS_POSIX
+        const int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw FileReadException(path_);
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw FileReadException(path_);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw FileReadException(path_);
+            }
+            mapping_ = mapping;
+            ::madvise(mapping_, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+        text_ = std::string_view(static_cast<const char*>(mapping_), size_);
+#else
+        std::FILE* file = std::fopen(path_.c_str(), "rb");
+        if (!file)
+            throw FileReadException(path_);
+        char chunk[64 * 1024];
+        for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;)
+            contents_.append(chunk, n);
+        std::fclose(file);
+        text_ = contents_;
+#endif
+    }
+
+    /** @brief Returns true for spaces and tabs. */
+    static bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    /** @brief Removes surrounding blanks. */
+    static std::string_view trim(std::string_view s) {
+        while (!s.empty() && is_blank(s.front()))
+            s.remove_prefix(1);
+        while (!s.empty() && is_blank(s.back()))
+            s.remove_suffix(1);
+        return s;
+    }
+
+    /**
+     * @brief Parses a value, removing quotes and trailing comments.
+     *
+     * @param raw Trimmed text after the separator.
+     * @param value Parsed value.
+     * @return false if a quoted value is not terminated.
+     */
+    bool parse_value(std::string_view raw, std::string_view& value) {
+        if (raw.empty() || (raw[0] != '"' && raw[0] != '\'')) {
+            for (std::size_t i = 1; i < raw.size(); ++i) {
+                if ((raw[i] == '#' || raw[i] == ';') && is_blank(raw[i - 1])) {
+                    raw = trim(raw.substr(0, i));
+                    break;
+                }
+            }
+            value = raw;
+            return true;
+        }
+
+        const char quote = raw[0];
+        std::size_t i = 1;
+        bool escaped = false;
+        for (; i < raw.size() && raw[i] != quote; ++i) {
+            if (quote == '"' && raw[i] == '\\' && i + 1 < raw.size()) {
+                escaped = true;
+                ++i;
+            }
+        }
+        if (i == raw.size())
+            return false;
+
+        value = raw.substr(1, i - 1);
+        if (escaped) {
+            std::string& out = owned_.emplace_back();
+            out.reserve(value.size());
+            for (std::size_t k = 0; k < value.size(); ++k) {
+                char c = value[k];
+                if (c == '\\' && k + 1 < value.size()) {
+                    c = value[++k];
+                    if (c == 'n')
+                        c = '\n';
+                    else if (c == 't')
+                        c = '\t';
+                }
+                out.push_back(c);
+            }
+            value = out;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parses text_ into options_ in a single pass.
+     */
+    void parse() {
+        std::string_view section;
+        std::size_t line_number = 0;
+
+        for (std::size_t pos = 0; pos < text_.size();) {
+            std::size_t end = text_.find('\n', pos);
+            if (end == std::string_view::npos)
+                end = text_.size();
+            const std::string_view line = trim(text_.substr(pos, end - pos));
+            pos = end + 1;
+            ++line_number;
+
+            if (line.empty() || line[0] == '#' || line[0] == ';')
+                continue;
+
+            if (line[0] == '[') {
+                if (line.back() != ']') {
+                    warn(line_number);
+                    continue;
+                }
+                section = trim(line.substr(1, line.size() - 2));
+                continue;
+            }
+
+            const std::size_t separator = line.find_first_of("=:");
+            std::string_view key =
+                separator == std::string_view::npos ? std::string_view() : trim(line.substr(0, separator));
+            std::string_view value;
+            if (key.empty() || !parse_value(trim(line.substr(separator + 1)), value)) {
+                warn(line_number);
+                continue;
+            }
+
+            if (!section.empty()) {
+                std::string& full = owned_.emplace_back();
+                full.reserve(section.size() + 1 + key.size());
+                full.append(section).append(1, '.').append(key);
+                key = full;
+            }
+            options_.assign(key, value);
+        }
+    }
+
+    /** @brief Reports a malformed line. */
+    void warn(std::size_t line_number) const {
+        Logger::warning("Malformed line ", line_number, " in config file '", path_, "' ignored");
+    }
+};
+
+}  // namespace Clixxi
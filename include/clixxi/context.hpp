@@ -9,10 +9,22 @@
 
 #pragma once
 
+#include <clixxi/convert.hpp>
 #include <clixxi/exception.hpp>
+#include <clixxi/input.hpp>
 #include <clixxi/logger.hpp>
+#include <clixxi/memory.hpp>
 #include <clixxi/option.hpp>
-#include <map>
+#include <clixxi/option_table.hpp>
+#include <clixxi/output.hpp>
+#include <clixxi/stats.hpp>
+#include <clixxi/trace.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace Clixxi {
@@ -22,62 +34,531 @@ namespace Clixxi {
  * @brief Represents parsed command execution context.
  *
  * Context is responsible for:
- * - parsing CLI arguments of the form `--key value`
- * - storing options internally as string key-value pairs
- * - providing typed access via `get_option<T>()`
+ * - parsing CLI arguments of the form `--key value`, `--key=value`,
+ *   `--no-flag`, `-k value` and bundled short flags (`-xvf`), up to `--`
+ * - exposing the remaining (positional) arguments as a lazy view over argv
+ * - storing options internally as string key-value pairs in a flat table
+ * - providing typed access via `get_option<T>()`, caching converted values
+ *
+ * Context is not synchronized: concurrent reads from several threads
+ * must be guarded by the caller, since conversion results are cached.
  *
  * Supported value types:
  * - bool
- * - int
- * - float
+ * - any integral or floating point type (int, std::int64_t, std::size_t, double, ...)
  * - std::string
+ * - std::string_view (view into the original argument, no copy)
+ * - ByteSize (`64MiB`)
+ * - std::chrono::duration (`250ms`)
+ * - std::vector of the above, collected from every occurrence and split at commas
+ *
+ * Conversion is performed by Clixxi::convert (see convert.hpp).
  */
 class Context {
+   public:
+    /**
+     * @class Positionals
+     * @brief Lazy forward range over the positional arguments of a Context.
+     *
+     * Iteration walks the original argv and skips option tokens on the fly,
+     * so no argument is copied or collected up front.
+     */
+    class Positionals {
+       public:
+        /**
+         * @class iterator
+         * @brief Forward iterator yielding std::string_view.
+         */
+        class iterator {
+           public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view*;
+            using reference = std::string_view;
+
+            iterator() = default;
+
+            std::string_view operator*() const { return argv_[index_]; }
+
+            iterator& operator++() {
+                index_ = literal_ ? index_ + 1 : skip_options(argv_, index_ + 1, argc_, literal_);
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+           private:
+            friend class Positionals;
+
+            const char* const* argv_ = nullptr; /**< Argument vector. */
+            int argc_ = 0;                      /**< Number of arguments. */
+            int index_ = 0;                     /**< Current positional argument. */
+            bool literal_ = false;              /**< Whether the `--` terminator was passed. */
+
+            iterator(const char* const* argv, int argc, int index, bool literal)
+                : argv_(argv), argc_(argc), index_(index), literal_(literal) {}
+        };
+
+        /** @brief Returns an iterator to the first positional argument. */
+        iterator begin() const {
+            bool literal = false;
+            const int index = skip_options(argv_, 0, argc_, literal);
+            return iterator(argv_, argc_, index, literal);
+        }
+
+        /** @brief Returns the past-the-end iterator. */
+        iterator end() const { return iterator(argv_, argc_, argc_, true); }
+
+        /** @brief Returns true if there are no positional arguments. */
+        bool empty() const { return begin() == end(); }
+
+        /** @brief Counts the positional arguments (walks the range). */
+        std::size_t size() const { return static_cast<std::size_t>(std::distance(begin(), end())); }
+
+       private:
+        friend class Context;
+
+        const char* const* argv_; /**< Argument vector. */
+        int argc_;                /**< Number of arguments. */
+
+        Positionals(const char* const* argv, int argc) : argv_(argv), argc_(argc) {}
+    };
+
+    /**
+     * @class Values
+     * @brief Contiguous range over all values of a repeated option.
+     */
+    class Values {
+       public:
+        using iterator = const std::string_view*; /**< Iterator type. */
+
+        Values() = default;
+
+        /** @brief Returns an iterator to the first value. */
+        iterator begin() const { return first_; }
+
+        /** @brief Returns the past-the-end iterator. */
+        iterator end() const { return last_; }
+
+        /** @brief Returns the number of values. */
+        std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+
+        /** @brief Returns true if the option was not given. */
+        bool empty() const { return first_ == last_; }
+
+        /** @brief Returns the value at index i (in command-line order). */
+        std::string_view operator[](std::size_t i) const { return first_[i]; }
+
+       private:
+        friend class Context;
+
+        const std::string_view* first_ = nullptr; /**< First value. */
+        const std::string_view* last_ = nullptr;  /**< Past the last value. */
+
+        Values(const std::string_view* first, const std::string_view* last) : first_(first), last_(last) {}
+    };
+
    private:
+    /**
+     * @brief Owned copies of arguments for the vector-based constructor.
+     *
+     * Empty when the Context was built directly over argv.
+     */
+    std::vector<std::string> owned_args_;
+
+    /**
+     * @brief Pointers to owned_args_, so both constructors share one argv view.
+     */
+    ArenaVector<const char*> owned_argv_;
+
+    const char* const* argv_ = nullptr; /**< Arguments the Context was built over. */
+    int argc_ = 0;                      /**< Number of entries in argv_. */
+
     /**
      * @brief Internal storage for parsed options.
      *
      * Keys are stored without leading dashes.
-     * Values are stored as raw strings.
+     * Keys and values are views into the original argument storage,
+     * kept in a flat hash-indexed table (see OptionTable).
      */
-    std::map<std::string, std::string> options_;
+    OptionTable options_;
 
-   public:
     /**
-     * @brief Constructs a Context from raw command arguments.
+     * @brief Shared option sources layered under options_, highest precedence first.
      *
-     * Expected option format:
-     *   --key value
-     *   --flag          (implicitly treated as true)
+     * Entries of these tables are shared between Contexts, so their values
+     * are converted without using the entry cache.
+     */
+    ArenaVector<const OptionTable*> sources_;
+
+    /**
+     * @struct Repeat
+     * @brief Later occurrence of an option that is already in options_.
+     */
+    struct Repeat {
+        std::uint32_t entry;    /**< Position of the option in options_. */
+        std::string_view value; /**< Value of this occurrence. */
+    };
+
+    /** @brief Repeated occurrences collected while parsing (cleared once grouped). */
+    ArenaVector<Repeat> repeats_;
+
+    /**
+     * @brief All values of every option, grouped by option in command-line order.
      *
-     * Non-option arguments (not starting with "--") are ignored.
+     * Built only when some option is repeated; the values of the option at
+     * position i are values_[value_offsets_[i]] to values_[value_offsets_[i + 1]].
+     */
+    ArenaVector<std::string_view> values_;
+    ArenaVector<std::uint32_t> value_offsets_; /**< Start of each option's values in values_. */
+
+    /**
+     * @brief Finds an option in the arguments, then in the layered sources.
      *
-     * @param args Vector of command arguments.
+     * @param name Option name.
+     * @param shared Set to true if the entry belongs to a shared source.
+     * @return Pointer to the entry, or nullptr if not found.
+     */
+    const OptionTable::Entry* find_entry(std::string_view name, bool& shared) const {
+        const std::uint32_t hash = hash_name(name);
+        shared = false;
+        CLIXXI_STAT(option_lookups);
+        if (const OptionTable::Entry* entry = options_.find(name, hash))
+            return entry;
+        shared = true;
+        for (const OptionTable* source : sources_) {
+            CLIXXI_STAT(option_lookups);
+            if (const OptionTable::Entry* entry = source->find(name, hash))
+                return entry;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Kinds of argument tokens.
+     */
+    enum class Token {
+        Positional, /**< Positional argument or option value (`file`, `-`, `-5`). */
+        Terminator, /**< `--`: every following argument is positional. */
+        Long,       /**< `--key`, `--key=value` or `--no-key`. */
+        Short,      /**< `-k` or a bundle of short flags (`-xvf`), optionally `-k=value`. */
+    };
+
+    /**
+     * @brief Classifies an argument by its first bytes.
+     *
+     * A dash followed by a digit or a dot is a (negative) number, not an option.
      */
-    explicit Context(const std::vector<std::string>& args) {
-        for (size_t i = 0; i < args.size(); ++i) {
-            const std::string& arg = args.at(i);
+    static Token classify(const char* arg) {
+        if (arg[0] != '-' || arg[1] == '\0')
+            return Token::Positional;
+        if (arg[1] == '-')
+            return arg[2] == '\0' ? Token::Terminator : Token::Long;
+        if ((arg[1] >= '0' && arg[1] <= '9') || arg[1] == '.')
+            return Token::Positional;
+        return Token::Short;
+    }
 
-            if (arg.substr(0, 2) != "--") {
-                continue;
+    /**
+     * @brief Checks whether the option at argv[i] takes argv[i + 1] as its value.
+     *
+     * True if the option has no inline `=value`, is not a `--no-` negation,
+     * and the next argument is not itself an option.
+     */
+    static bool takes_value(const char* const* argv, int i, int argc) {
+        const char* arg = argv[i];
+        if (!value_follows(argv, i, argc) || std::strchr(arg, '=') != nullptr)
+            return false;
+        return !(arg[1] == '-' && std::strncmp(arg + 2, "no-", 3) == 0 && arg[5] != '\0');
+    }
+
+    /** @brief Checks whether argv[i + 1] exists and is not an option. */
+    static bool value_follows(const char* const* argv, int i, int argc) {
+        return i + 1 < argc && classify(argv[i + 1]) == Token::Positional;
+    }
+
+    /**
+     * @brief Returns the index of the first positional argument at or after i.
+     *
+     * @param literal Set to true once the `--` terminator is passed; from then
+     *                on every argument is positional.
+     * @return Index of the argument, or argc if there is none.
+     */
+    static int skip_options(const char* const* argv, int i, int argc, bool& literal) {
+        while (i < argc) {
+            switch (classify(argv[i])) {
+                case Token::Positional:
+                    return i;
+                case Token::Terminator:
+                    literal = true;
+                    return i + 1;
+                case Token::Long:
+                case Token::Short:
+                    i += takes_value(argv, i, argc) ? 2 : 1;
+                    break;
             }
+        }
+        return i;
+    }
 
-            std::string key = arg.substr(2), value;
+    /**
+     * @brief Parses argv_ into options_ in a single pass over the tokens.
+     *
+     * Each token is classified once by its first bytes; option names and
+     * values are views into argv, so parsing does not allocate beyond the
+     * option table itself. get_option() returns the first occurrence of an
+     * option; get_values() returns all of them.
+     */
+    void parse() {
+        int count = 0;
+        for (int i = 0; i < argc_; ++i)
+            count += argv_[i][0] == '-';
+        options_.reserve(static_cast<std::size_t>(count));
 
-            if (i + 1 < args.size() && args.at(i + 1).substr(0, 2) != "--") {
-                value = args.at(i + 1);
-                ++i;
-            } else {
-                value = "true";
+        for (int i = 0; i < argc_; ++i) {
+            const char* arg = argv_[i];
+            switch (classify(arg)) {
+                case Token::Positional:
+                    break;
+                case Token::Terminator:
+                    i = argc_;
+                    break;
+                case Token::Long: {
+                    const std::string_view body(arg + 2);
+                    const std::size_t equals = body.find('=');
+                    if (equals != std::string_view::npos) {
+                        add(body.substr(0, equals), body.substr(equals + 1));
+                    } else if (body.size() > 3 && body.compare(0, 3, "no-") == 0) {
+                        add(body.substr(3), "false");
+                    } else if (value_follows(argv_, i, argc_)) {
+                        add(body, argv_[++i]);
+                    } else {
+                        add(body, "true");
+                    }
+                    break;
+                }
+                case Token::Short: {
+                    // Every letter but the last is a flag; the last one may take a value.
+                    const char* letter = arg + 1;
+                    for (; letter[1] != '\0' && letter[1] != '='; ++letter)
+                        add(std::string_view(letter, 1), "true");
+                    const std::string_view key(letter, 1);
+                    if (letter[1] == '=')
+                        add(key, letter + 2);
+                    else if (value_follows(argv_, i, argc_))
+                        add(key, argv_[++i]);
+                    else
+                        add(key, "true");
+                    break;
+                }
             }
+        }
+
+        if (!repeats_.empty())
+            group_repeats();
+    }
+
+    /**
+     * @brief Stores an option occurrence, recording repeats of known options.
+     */
+    void add(std::string_view key, std::string_view value) {
+        bool inserted;
+        const std::size_t entry = options_.insert(key, value, hash_name(key), inserted);
+        if (!inserted)
+            repeats_.push_back(Repeat{static_cast<std::uint32_t>(entry), value});
+    }
+
+    /**
+     * @brief Groups all values by option into values_ (counting sort, linear time).
+     */
+    void group_repeats() {
+        const std::size_t count = options_.size();
+        value_offsets_.assign(count + 1, 0);
+        for (const Repeat& repeat : repeats_)
+            ++value_offsets_[repeat.entry + 1];
+        for (std::size_t i = 0; i < count; ++i)
+            value_offsets_[i + 1] += value_offsets_[i] + 1;
+
+        values_.resize(value_offsets_[count]);
+        ArenaVector<std::uint32_t> next(value_offsets_.begin(), value_offsets_.end() - 1,
+                                        value_offsets_.get_allocator());
+        for (std::size_t i = 0; i < count; ++i)
+            values_[next[i]++] = options_[i].value;
+        for (const Repeat& repeat : repeats_)
+            values_[next[repeat.entry]++] = repeat.value;
+        repeats_.clear();
+    }
+
+    /**
+     * @brief Appends the comma-separated elements of every value to a list.
+     *
+     * @return true on success, false if an element cannot be converted.
+     */
+    template <typename T>
+    static bool collect_list(const Values& values, T& out) {
+        std::size_t count = 0;
+        for (std::string_view value : values)
+            count += 1 + static_cast<std::size_t>(std::count(value.begin(), value.end(), ','));
+        out.reserve(out.size() + count);
+        CLIXXI_STAT_ADD(conversions, count);
+        for (std::string_view value : values) {
+            if (!append_list(value, out))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Returns all values of an entry found by find_entry().
+     */
+    Values values_of(const OptionTable::Entry& entry, bool shared) const {
+        if (shared || values_.empty())
+            return Values(&entry.value, &entry.value + 1);
+        const std::size_t i = static_cast<std::size_t>(&entry - &options_[0]);
+        return Values(values_.data() + value_offsets_[i], values_.data() + value_offsets_[i + 1]);
+    }
 
-            options_.emplace(key, value);
+    /**
+     * @brief Returns the value of an entry as type T, using the entry cache.
+     *
+     * Strings are returned directly from the raw value. Other types are
+     * converted once and stored in the entry's OptionType cache when
+     * OptionType can hold them.
+     *
+     * @tparam T Desired type.
+     * @param entry Option table entry.
+     * @param out Converted value.
+     * @param shared Whether the entry belongs to a shared source (never cached).
+     * @return true on success, false if the value cannot be converted.
+     */
+    template <typename T>
+    static bool lookup_value(const OptionTable::Entry& entry, T& out, bool shared) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            out = T(entry.value);
+            return true;
+        } else if constexpr (is_option_type<T>()) {
+            if (shared) {
+                CLIXXI_STAT(conversions);
+                return convert(entry.value, out);
+            }
+            if (entry.cached && std::holds_alternative<T>(entry.cache)) {
+                CLIXXI_STAT(cache_hits);
+                out = std::get<T>(entry.cache);
+                return true;
+            }
+            CLIXXI_STAT(conversions);
+            if (!convert(entry.value, out)) {
+                return false;
+            }
+            entry.cache = out;
+            entry.cached = true;
+            return true;
+        } else {
+            CLIXXI_STAT(conversions);
+            return convert(entry.value, out);
         }
     }
 
+   public:
+    /**
+     * @brief Constructs a Context from raw command arguments.
+     *
+     * Accepted option formats:
+     *   --key value, --key=value
+     *   --flag          (implicitly treated as true)
+     *   --no-flag       (treated as false)
+     *   -k value, -k=value, -xvf (bundled flags; the last may take a value)
+     *   --              (every following argument is positional)
+     *
+     * Other arguments are positional (see positionals()).
+     * Arguments are copied, so the vector may be destroyed after construction.
+     *
+     * @param args Vector of command arguments.
+     * @param resource Memory resource for the parse state (must outlive the Context).
+     */
+    explicit Context(const std::vector<std::string>& args, MemoryResource* resource = default_memory_resource())
+        : owned_args_(args),
+          owned_argv_(resource),
+          options_(resource),
+          sources_(resource),
+          repeats_(resource),
+          values_(resource),
+          value_offsets_(resource) {
+        owned_argv_.reserve(owned_args_.size());
+        for (const std::string& arg : owned_args_)
+            owned_argv_.push_back(arg.c_str());
+        argv_ = owned_argv_.data();
+        argc_ = static_cast<int>(owned_argv_.size());
+        parse();
+    }
+
+    /**
+     * @brief Constructs a Context directly over an argv range without copying.
+     *
+     * Options are stored as views into argv, so no per-token allocation occurs.
+     * The argv storage must outlive the Context (true for main's argv).
+     *
+     * With an Arena resource, the option table and source list come from the
+     * arena too, so parsing one invocation makes no heap allocation at all.
+     *
+     * @param argc Number of arguments in argv.
+     * @param argv Argument vector (not including the program or command name).
+     * @param resource Memory resource for the parse state (must outlive the Context).
+     */
+    Context(int argc, const char* const* argv, MemoryResource* resource = default_memory_resource())
+        : owned_argv_(resource),
+          argv_(argv),
+          argc_(argc > 0 ? argc : 0),
+          options_(resource),
+          sources_(resource),
+          repeats_(resource),
+          values_(resource),
+          value_offsets_(resource) {
+        parse();
+    }
+
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+    Context(Context&&) = default;
+
+    /**
+     * @brief Takes over the arguments and parse state of another Context.
+     *
+     * The parse state keeps this Context's memory resource. When the two
+     * resources differ, owned_argv_ is copied element-wise instead of
+     * adopted, so argv_ is re-pointed at the copy.
+     */
+    Context& operator=(Context&& other) {
+        if (this == &other)
+            return *this;
+        owned_args_ = std::move(other.owned_args_);
+        owned_argv_ = std::move(other.owned_argv_);
+        argv_ = other.argv_;
+        argc_ = other.argc_;
+        if (!owned_args_.empty())
+            argv_ = owned_argv_.data();
+        options_ = std::move(other.options_);
+        sources_ = std::move(other.sources_);
+        repeats_ = std::move(other.repeats_);
+        values_ = std::move(other.values_);
+        value_offsets_ = std::move(other.value_offsets_);
+        return *this;
+    }
+
     /**
      * @brief Retrieves an option value converted to type T.
      *
+     * The converted value is cached next to the raw string, so repeated
+     * calls with the same type do not reparse the value.
+     *
      * @tparam T Desired return type.
      * @param name Option name.
      * @return Converted option value.
@@ -86,55 +567,30 @@ class Context {
      * @throws `BadOptionTypeException` - If conversion fails.
      */
     template <typename T>
-    T get_option(const std::string& name) const {
-        auto it = options_.find(name);
+    T get_option(std::string_view name) const {
+        const ConversionTimer timer;
+        CLIXXI_STATS_SCOPE(true);
+        bool shared;
+        const OptionTable::Entry* entry = find_entry(name, shared);
 
-        if (it == options_.end()) {
+        if (!entry) {
             if constexpr (std::is_same_v<T, bool>) {
                 return false;
             } else {
-                throw MissingRequiredOptionException(name);
+                throw MissingRequiredOptionException(std::string(name));
             }
         }
 
-        const std::string& value = it->second;
-
-        if constexpr (std::is_same_v<T, std::string>) {
-            return value;
-        } else if constexpr (std::is_same_v<T, bool>) {
-            if (value == "true" || value == "1" || value == "on" || value == "yes") {
-                return true;
-            }
-            if (value == "false" || value == "0" || value == "off" || value == "no") {
-                return false;
-            }
-            throw BadOptionTypeException(name, "bool");
-        } else if constexpr (std::is_same_v<T, int>) {
-            try {
-                size_t pos;
-                int result = std::stoi(value, &pos);
-                if (pos != value.size()) {
-                    throw BadOptionTypeException(name, "int");
-                }
-                return result;
-            } catch (...) {
-                throw BadOptionTypeException(name, "int");
-            }
-        } else if constexpr (std::is_same_v<T, float>) {
-            try {
-                size_t pos;
-                float result = std::stof(value, &pos);
-                if (pos != value.size()) {
-                    throw BadOptionTypeException(name, "float");
-                }
-                return result;
-            } catch (...) {
-                throw BadOptionTypeException(name, "float");
-            }
-
-        } else {
-            throw BadOptionTypeException(name, "unknown type");
+        T result{};
+        if constexpr (is_list<T>::value) {
+            if (!collect_list(values_of(*entry, shared), result))
+                throw BadOptionTypeException(std::string(name), type_name<T>());
+            return result;
+        }
+        if (!lookup_value(*entry, result, shared)) {
+            throw BadOptionTypeException(std::string(name), type_name<T>());
         }
+        return result;
     }
 
     /**
@@ -142,6 +598,7 @@ class Context {
      *
      * If the option is missing, returns default_value.
      * If type conversion fails, logs a warning and returns default_value.
+     * This overload never constructs or throws exceptions.
      *
      * @tparam T Desired return type.
      * @param name Option name.
@@ -149,15 +606,61 @@ class Context {
      * @return Converted option value or default.
      */
     template <typename T>
-    T get_option(const std::string& name, const T& default_value) const {
-        try {
-            return get_option<T>(name);
-        } catch (const MissingRequiredOptionException&) {
+    T get_option(std::string_view name, const T& default_value) const {
+        const ConversionTimer timer;
+        CLIXXI_STATS_SCOPE(true);
+        bool shared;
+        const OptionTable::Entry* entry = find_entry(name, shared);
+
+        if (!entry) {
             return default_value;
-        } catch (const BadOptionTypeException& e) {
-            Clixxi::Logger::get().warning(e.what());
+        }
+
+        T result{};
+        bool converted;
+        if constexpr (is_list<T>::value)
+            converted = collect_list(values_of(*entry, shared), result);
+        else
+            converted = lookup_value(*entry, result, shared);
+        if (!converted) {
+            Clixxi::Logger::warning("Option '", name, "' cannot be converted to ", type_name<T>());
             return default_value;
         }
+        return result;
+    }
+
+    /**
+     * @brief Converts an option if it is present, with a single lookup.
+     *
+     * Unlike has_option() followed by get_option(), the option table is
+     * probed once. Used by Schema to load every option exactly once.
+     *
+     * @tparam T Desired type.
+     * @param name Option name.
+     * @param out Converted value (unchanged if the option is absent).
+     * @return true if the option was found, false if it is absent.
+     *
+     * @throws `BadOptionTypeException` - If the option is present but cannot be converted.
+     */
+    template <typename T>
+    bool find_option(std::string_view name, T& out) const {
+        const ConversionTimer timer;
+        CLIXXI_STATS_SCOPE(true);
+        bool shared;
+        const OptionTable::Entry* entry = find_entry(name, shared);
+        if (!entry)
+            return false;
+
+        T result{};
+        bool converted;
+        if constexpr (is_list<T>::value)
+            converted = collect_list(values_of(*entry, shared), result);
+        else
+            converted = lookup_value(*entry, result, shared);
+        if (!converted)
+            throw BadOptionTypeException(std::string(name), type_name<T>());
+        out = std::move(result);
+        return true;
     }
 
     /**
@@ -166,7 +669,106 @@ class Context {
      * @param name Option name.
      * @return true if option was provided, false otherwise.
      */
-    bool has_option(const std::string& name) const { return options_.find(name) != options_.end(); }
+    bool has_option(std::string_view name) const {
+        bool shared;
+        return find_entry(name, shared) != nullptr;
+    }
+
+    /**
+     * @brief Returns every value given for an option, in command-line order.
+     *
+     * `--include a --include b` yields {"a", "b"}. Options found only in a
+     * layered source have a single value. The range is stored contiguously
+     * and stays valid as long as the Context.
+     *
+     * @param name Option name.
+     * @return Range of std::string_view (empty if the option is absent).
+     */
+    Values get_values(std::string_view name) const {
+        bool shared;
+        const OptionTable::Entry* entry = find_entry(name, shared);
+        return entry ? values_of(*entry, shared) : Values();
+    }
+
+    /**
+     * @brief Layers a shared option source (for example a ConfigFile) under the arguments.
+     *
+     * Precedence, highest first: command-line arguments, then sources in
+     * the order they were added. The source must outlive the Context and
+     * must not change while the Context is used.
+     *
+     * @param source Option table to fall back to.
+     */
+    void add_source(const OptionTable& source) { sources_.push_back(&source); }
+
+    /**
+     * @brief Returns the output sink of the running command.
+     *
+     * Text written here is buffered and flushed when the command exits;
+     * in App::serve() and App::run_parallel() it is routed like std::cout.
+     *
+     * @return The calling thread's current Output.
+     */
+    Output& out() const { return Output::current(); }
+
+    /**
+     * @brief Returns the positional arguments as a lazy view over argv.
+     *
+     * Positional arguments are those that are neither options nor option
+     * values. The view stays valid as long as the Context and its argv.
+     *
+     * @return Range of std::string_view.
+     */
+    Positionals positionals() const { return Positionals(argv_, argc_); }
+
+    /**
+     * @brief Streams positional arguments, expanding stdin and response files.
+     *
+     * Calls fn for each positional argument in order. Depending on options,
+     * `@path` is replaced by the records of that file and `-` by the records
+     * of stdin; both are read incrementally, so fn sees the first record
+     * before the rest has been read. A view passed to fn for a record read
+     * from a stream is valid only during the call.
+     *
+     * Example:
+     * @code
+     * // tool process @files.txt   or   find . | tool process -
+     * ctx.for_each_input([&](std::string_view path) { process(path); });
+     * @endcode
+     *
+     * @tparam F Callable taking std::string_view.
+     * @param fn Argument consumer.
+     * @param options Expansion settings.
+     *
+     * @throws `FileReadException` - If a response file cannot be opened.
+     */
+    template <typename F>
+    void for_each_input(F&& fn, const InputOptions& options = {}) const {
+        const Positionals args = positionals();
+
+        if (options.stdin_if_empty && args.empty()) {
+            for_each_record(stdin, options.delimiter, fn);
+            return;
+        }
+
+        for (std::string_view arg : args) {
+            if (options.dash_is_stdin && arg == "-") {
+                for_each_record(stdin, options.delimiter, fn);
+            } else if (options.response_files && arg.size() > 1 && arg[0] == '@') {
+                const char* path = arg.data() + 1;  // arg points into a null-terminated argv entry.
+                std::FILE* file = std::fopen(path, "r");
+                if (!file)
+                    throw FileReadException(path);
+                struct Closer {
+                    std::FILE* file;
+                    ~Closer() { std::fclose(file); }
+                } closer{file};
+                for_each_record(file, options.delimiter, fn);
+            } else {
+                fn(arg);
+            }
+        }
+    }
 };
 
 }  // namespace Clixxi
\ No newline at end of file
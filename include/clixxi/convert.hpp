@@ -0,0 +1,333 @@
+/**
+ * @file convert.hpp
+ * @brief Provides locale-independent, non-throwing conversion of option values.
+ *
+ * All numeric conversions are built on std::from_chars, so they never
+ * allocate, never throw and do not depend on the current locale.
+ * In addition to plain numbers, byte sizes (`64MiB`) and durations
+ * (`250ms`) are supported.
+ */
+
+#pragma once
+
+#include <clixxi/option.hpp>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Clixxi {
+
+/**
+ * @brief Trait that detects std::chrono::duration specializations.
+ */
+template <typename T>
+struct is_duration : std::false_type {};
+
+template <typename Rep, typename Period>
+struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+/**
+ * @brief Trait that detects std::vector specializations (list options).
+ */
+template <typename T>
+struct is_list : std::false_type {};
+
+template <typename T, typename Alloc>
+struct is_list<std::vector<T, Alloc>> : std::true_type {};
+
+/**
+ * @brief Returns a human-readable name of a supported option type.
+ *
+ * @tparam T Option type.
+ * @return Type name used in error messages.
+ */
+template <typename T>
+const char* type_name() {
+    if constexpr (std::is_same_v<T, bool>) {
+        return "bool";
+    } else if constexpr (std::is_same_v<T, int>) {
+        return "int";
+    } else if constexpr (std::is_same_v<T, float>) {
+        return "float";
+    } else if constexpr (std::is_same_v<T, double>) {
+        return "double";
+    } else if constexpr (std::is_same_v<T, std::int64_t>) {
+        return "int64";
+    } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+        return "uint64";
+    } else if constexpr (std::is_same_v<T, std::size_t>) {
+        return "size";
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        return "integer";
+    } else if constexpr (std::is_integral_v<T>) {
+        return "unsigned integer";
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return "floating point";
+    } else if constexpr (std::is_same_v<T, ByteSize>) {
+        return "byte size";
+    } else if constexpr (is_duration<T>::value) {
+        return "duration";
+    } else if constexpr (is_list<T>::value) {
+        return "list";
+    } else {
+        return "string";
+    }
+}
+
+/**
+ * @brief Parses a leading number from a string using std::from_chars.
+ *
+ * A leading '+' is accepted for compatibility with std::stoi/std::stof.
+ *
+ * @tparam T Arithmetic type.
+ * @param str Input string.
+ * @param out Parsed number.
+ * @return Number of consumed characters, or 0 on failure.
+ */
+template <typename T>
+std::size_t parse_number(std::string_view str, T& out) {
+    const char* first = str.data();
+    const char* last = str.data() + str.size();
+
+    if (first != last && *first == '+' && first + 1 != last && *(first + 1) != '-')
+        ++first;
+
+    std::from_chars_result res{};
+    if constexpr (std::is_floating_point_v<T>) {
+        res = std::from_chars(first, last, out, std::chars_format::general);
+    } else {
+        res = std::from_chars(first, last, out);
+    }
+
+    if (res.ec != std::errc())
+        return 0;
+    return static_cast<std::size_t>(res.ptr - str.data());
+}
+
+/**
+ * @brief Parses a number followed by an optional unit suffix.
+ *
+ * The number may be an integer (parsed exactly) or a decimal fraction. Looks up the suffix
+ * with the supplied callable and scales the number by the returned factor.
+ *
+ * @param str Input string.
+ * @param unit Callable mapping a suffix to its factor (0 if unknown).
+ * @param out Scaled value.
+ * @return true on success.
+ */
+template <typename Unit>
+bool parse_scaled(std::string_view str, Unit&& unit, long double& out) {
+    long double number = 0;
+    std::uint64_t integer = 0;
+    std::size_t pos = parse_number(str, integer);
+
+    if (pos != 0 && (pos == str.size() || (str[pos] != '.' && str[pos] != 'e' && str[pos] != 'E'))) {
+        number = static_cast<long double>(integer);
+    } else {
+        double fraction = 0;
+        pos = parse_number(str, fraction);
+        if (pos == 0)
+            return false;
+        number = fraction;
+    }
+
+    const long double factor = unit(str.substr(pos));
+    if (factor == 0)
+        return false;
+
+    out = number * factor;
+    return true;
+}
+
+/**
+ * @brief Returns the multiplier of a byte size suffix.
+ *
+ * Single letters (K, M, G, T) and `iB` forms are binary (powers of 1024),
+ * `B` forms (KB, MB, GB, TB) are decimal (powers of 1000).
+ *
+ * @param suffix Unit suffix (may be empty).
+ * @return Number of bytes per unit, or 0 if the suffix is unknown.
+ */
+inline long double byte_unit(std::string_view suffix) {
+    struct Unit {
+        std::string_view name;
+        long double factor;
+    };
+    static constexpr Unit units[] = {
+        {"", 1.0L},
+        {"B", 1.0L},
+        {"K", 1024.0L},
+        {"k", 1024.0L},
+        {"KiB", 1024.0L},
+        {"KB", 1e3L},
+        {"M", 1048576.0L},
+        {"MiB", 1048576.0L},
+        {"MB", 1e6L},
+        {"G", 1073741824.0L},
+        {"GiB", 1073741824.0L},
+        {"GB", 1e9L},
+        {"T", 1099511627776.0L},
+        {"TiB", 1099511627776.0L},
+        {"TB", 1e12L},
+    };
+    for (const Unit& u : units) {
+        if (u.name == suffix)
+            return u.factor;
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the length of a duration suffix in nanoseconds.
+ *
+ * @param suffix Unit suffix: ns, us, ms, s, m/min, h or d.
+ * @param bare Factor used when the suffix is empty.
+ * @return Nanoseconds per unit, or 0 if the suffix is unknown.
+ */
+inline long double duration_unit(std::string_view suffix, long double bare) {
+    struct Unit {
+        std::string_view name;
+        long double factor;
+    };
+    static constexpr Unit units[] = {
+        {"ns", 1.0L},  {"us", 1e3L},   {"ms", 1e6L},   {"s", 1e9L},
+        {"m", 60e9L},  {"min", 60e9L}, {"h", 3600e9L}, {"d", 86400e9L},
+    };
+    if (suffix.empty())
+        return bare;
+    for (const Unit& u : units) {
+        if (u.name == suffix)
+            return u.factor;
+    }
+    return 0;
+}
+
+/**
+ * @brief Converts a raw option value to type T without throwing.
+ *
+ * Supported types:
+ * - bool (true/false, 1/0, on/off, yes/no)
+ * - any integral or floating point type (std::from_chars)
+ * - std::string, std::string_view
+ * - ByteSize (`4096`, `64MiB`, `1.5G`, `10MB`)
+ * - std::chrono::duration (`250ms`, `1.5s`, `2h`; bare numbers are in units of T)
+ *
+ * Decimal byte sizes and durations are rounded to the nearest unit of the
+ * target (half away from zero), so the binary representation of a fraction
+ * does not cost a unit: as std::chrono::milliseconds, `0.3s` is 300ms,
+ * `1.15s` is 1150ms and `2.3h` is 8280000ms; `0.3KB` is 300 bytes.
+ * - std::vector of any of the above (comma-separated, see append_list())
+ *
+ * @tparam T Desired type.
+ * @param value Raw option value.
+ * @param out Converted value (unchanged on failure).
+ * @return true on success, false if the value cannot be converted.
+ */
+template <typename T>
+bool convert(std::string_view value, T& out);
+
+/**
+ * @brief Appends the comma-separated elements of a raw value to a list.
+ *
+ * Every element is converted with convert(). An empty value adds nothing.
+ *
+ * @tparam T Element type.
+ * @param value Raw option value (`a,b,c`).
+ * @param out List to append to (unchanged on failure).
+ * @return true on success, false if an element cannot be converted.
+ */
+template <typename T, typename Alloc>
+bool append_list(std::string_view value, std::vector<T, Alloc>& out) {
+    if (value.empty())
+        return true;
+    const std::size_t size = out.size();
+    for (;;) {
+        const std::size_t comma = value.find(',');
+        T element{};
+        if (!convert(value.substr(0, comma), element)) {
+            out.resize(size);
+            return false;
+        }
+        out.push_back(std::move(element));
+        if (comma == std::string_view::npos)
+            return true;
+        value.remove_prefix(comma + 1);
+    }
+}
+
+template <typename T>
+bool convert(std::string_view value, T& out) {
+    if constexpr (std::is_same_v<T, bool>) {
+        if (value == "true" || value == "1" || value == "on" || value == "yes") {
+            out = true;
+            return true;
+        }
+        if (value == "false" || value == "0" || value == "off" || value == "no") {
+            out = false;
+            return true;
+        }
+        return false;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        T result{};
+        if (value.empty() || parse_number(value, result) != value.size())
+            return false;
+        out = result;
+        return true;
+    } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+        out = T(value);
+        return true;
+    } else if constexpr (std::is_same_v<T, ByteSize>) {
+        long double bytes = 0;
+        if (!parse_scaled(value, byte_unit, bytes) || !std::isfinite(bytes))
+            return false;
+        // 2^64 is exact in every long double format, unlike UINT64_MAX (rounded up to 2^64 where it is a double).
+        bytes = std::round(bytes);
+        if (bytes < 0 || bytes >= 0x1p64L)
+            return false;
+        out = ByteSize{static_cast<std::uint64_t>(bytes)};
+        return true;
+    } else if constexpr (is_duration<T>::value) {
+        using Period = typename T::period;
+        const long double bare = 1e9L * Period::num / Period::den;
+        long double ns = 0;
+        auto unit = [bare](std::string_view suffix) { return duration_unit(suffix, bare); };
+        if (!parse_scaled(value, unit, ns) || !std::isfinite(ns))
+            return false;
+
+        using Rep = typename T::rep;
+        long double count = ns * Period::den / (1e9L * Period::num);
+        if (!std::isfinite(count))
+            return false;
+        if constexpr (std::is_integral_v<Rep>) {
+            // Bounds as exact powers of two: the maximum itself may round up when converted.
+            count = std::round(count);
+            const long double limit = std::ldexp(1.0L, std::numeric_limits<Rep>::digits);
+            if (count >= limit || count < static_cast<long double>(std::numeric_limits<Rep>::lowest()))
+                return false;
+        } else if (count > static_cast<long double>(std::numeric_limits<Rep>::max()) ||
+                   count < static_cast<long double>(std::numeric_limits<Rep>::lowest())) {
+            return false;
+        }
+        out = T(static_cast<Rep>(count));
+        return true;
+    } else if constexpr (is_list<T>::value) {
+        T result;
+        if (!append_list(value, result))
+            return false;
+        out = std::move(result);
+        return true;
+    } else {
+        static_assert(sizeof(T) == 0, "Unsupported option type");
+        return false;
+    }
+}
+
+}  // namespace Clixxi
@@ -0,0 +1,112 @@
+/**
+ * @file env.hpp
+ * @brief Provides an environment-variable option source.
+ *
+ * EnvSource maps environment variables to option names (for example
+ * APP_THREADS to --threads) and resolves all of them with a single pass
+ * over the process environment, instead of one getenv() call per option.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+#include <clixxi/option_table.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#ifdef CLIXXI_HAS_POSIX
+extern "C" char** environ;
+#endif
+
+namespace Clixxi {
+
+/**
+ * @class EnvSource
+ * @brief Option table filled from bound environment variables.
+ *
+ * Bindings are kept in an OptionTable keyed by variable name. During the
+ * scan, entries of the environment that do not start with the common
+ * prefix of all bound names (for example "APP_") are rejected with a
+ * single comparison; the rest are looked up by hash.
+ *
+ * The environment is read once, on the first call to options() after a
+ * binding was added. Values are views into the environment strings.
+ */
+class EnvSource {
+   public:
+    /**
+     * @brief Binds an environment variable to an option.
+     *
+     * Both strings are viewed, not copied, and must outlive the source.
+     *
+     * @param variable Environment variable name.
+     * @param option Option name (without leading dashes).
+     */
+    void bind(std::string_view variable, std::string_view option) {
+        if (!bindings_.emplace(variable, option))
+            return;
+        if (bindings_.size() == 1) {
+            prefix_ = variable;
+        } else {
+            std::size_t n = 0;
+            while (n < prefix_.size() && n < variable.size() && prefix_[n] == variable[n])
+                ++n;
+            prefix_ = prefix_.substr(0, n);
+        }
+        resolved_ = false;
+    }
+
+    /** @brief Returns true if no variable is bound. */
+    bool empty() const { return bindings_.empty(); }
+
+    /**
+     * @brief Returns the options found in the environment, scanning it on first use.
+     *
+     * @return Table mapping option names to variable values.
+     */
+    const OptionTable& options() {
+        if (!resolved_) {
+            values_ = OptionTable();
+            scan();
+            resolved_ = true;
+        }
+        return values_;
+    }
+
+   private:
+    OptionTable bindings_;    /**< Variable name -> option name. */
+    std::string_view prefix_; /**< Longest common prefix of the bound variable names. */
+    OptionTable values_;      /**< Option name -> variable value. */
+    bool resolved_ = false;   /**< Whether values_ reflects the current bindings. */
+
+    /**
+     * @brief Fills values_ from the environment.
+     */
+    void scan() {
+#ifdef CLIXXI_HAS_POSIX
+        for (char** entry = environ; entry && *entry; ++entry) {
+            const char* text = *entry;
+            if (std::strncmp(text, prefix_.data(), prefix_.size()) != 0)
+                continue;
+            const char* equals = std::strchr(text + prefix_.size(), '=');
+            if (!equals)
+                continue;
+            const std::string_view name(text, static_cast<std::size_t>(equals - text));
+            if (const OptionTable::Entry* binding = bindings_.find(name))
+                values_.emplace(binding->value, std::string_view(equals + 1));
+        }
+#else
+        for (const OptionTable::Entry& binding : bindings_) {
+            const std::string variable(binding.key);
+            if (const char* value = std::getenv(variable.c_str()))
+                values_.emplace(binding.value, std::string_view(value));
+        }
+#endif
+    }
+};
+
+}  // namespace Clixxi
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <clixxi/stats.hpp>
+
 #include <stdexcept>
 #include <string>
 
@@ -27,12 +29,12 @@ struct Exception : std::runtime_error {
      * @brief Constructs an exception with a message.
      * @param msg Error description.
      */
-    explicit Exception(const std::string& msg) : std::runtime_error(msg) {}
+    explicit Exception(const std::string& msg) : std::runtime_error(msg) { CLIXXI_STAT(exceptions_thrown); }
     /**
      * @brief Constructs an exception with a C-string message.
      * @param msg Error description.
      */
-    explicit Exception(const char* msg) : std::runtime_error(msg) {}
+    explicit Exception(const char* msg) : std::runtime_error(msg) { CLIXXI_STAT(exceptions_thrown); }
 };
 
 /**
@@ -101,4 +103,17 @@ struct CommandHasNotHandlerException : Exception {
         : Exception("Command '" + name + "' has not handler") {}
 };
 
+/**
+ * @struct FileReadException
+ * @brief Thrown when an input file (for example a response file) cannot be read.
+ */
+struct FileReadException : Exception {
+    /**
+     * @brief Constructs an exception for an unreadable file.
+     * @param path Path of the file.
+     */
+    explicit FileReadException(const std::string& path)
+        : Exception("Cannot read file '" + path + "'") {}
+};
+
 }  // namespace Clixxi
\ No newline at end of file
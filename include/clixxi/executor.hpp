@@ -0,0 +1,266 @@
+/**
+ * @file executor.hpp
+ * @brief Provides a work-stealing thread pool and per-task output buffering.
+ *
+ * WorkStealingExecutor runs independent tasks across cores, and
+ * RoutedStreamBuf captures output written to std::cout by each task
+ * into its own buffer, so output from concurrent tasks never interleaves.
+ * Both are used by App::run_parallel().
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Clixxi {
+
+/**
+ * @class WorkStealingExecutor
+ * @brief Fixed-size thread pool with per-thread task deques.
+ *
+ * Each worker pops tasks from the back of its own deque and, when it runs
+ * dry, steals from the front of the other workers' deques. Tasks submitted
+ * from a worker go to that worker's deque; tasks submitted from outside are
+ * distributed round-robin.
+ *
+ * Example:
+ * @code
+ * Clixxi::WorkStealingExecutor executor(4);
+ * for (int i = 0; i < 100; ++i)
+ *     executor.submit([i] { process(i); });
+ * executor.wait();
+ * @endcode
+ */
+class WorkStealingExecutor {
+   public:
+    /** @brief Task type. */
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param threads Number of workers (0 selects std::thread::hardware_concurrency()).
+     */
+    explicit WorkStealingExecutor(std::size_t threads = 0) {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+
+        queues_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            queues_.push_back(std::make_unique<Queue>());
+        threads_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            threads_.emplace_back([this, i] { work(i); });
+    }
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    /**
+     * @brief Waits for queued tasks to finish and stops the workers.
+     */
+    ~WorkStealingExecutor() {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (std::thread& thread : threads_)
+            thread.join();
+    }
+
+    /** @brief Returns the number of worker threads. */
+    std::size_t size() const { return threads_.size(); }
+
+    /**
+     * @brief Queues a task for execution.
+     *
+     * Tasks must not throw; exceptions escaping a task terminate the program.
+     *
+     * @param task Task to run.
+     */
+    void submit(Task task) {
+        const std::size_t target = current_owner() == this ? current_worker() : next_.fetch_add(1) % queues_.size();
+        pending_.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+            queues_[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++queued_;
+        }
+        work_cv_.notify_one();
+    }
+
+    /**
+     * @brief Blocks until every submitted task has finished.
+     *
+     * Must not be called from a worker thread.
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return pending_.load() == 0; });
+    }
+
+   private:
+    /**
+     * @struct Queue
+     * @brief Task deque owned by one worker.
+     */
+    struct Queue {
+        std::mutex mutex;       /**< Guards tasks. */
+        std::deque<Task> tasks; /**< Owner pops from the back, thieves from the front. */
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_; /**< Per-worker deques. */
+    std::vector<std::thread> threads_;           /**< Worker threads. */
+    std::mutex mutex_;                           /**< Guards queued_, stop_ and the condition variables. */
+    std::condition_variable work_cv_;            /**< Signals queued work or shutdown. */
+    std::condition_variable done_cv_;            /**< Signals that all tasks have finished. */
+    std::size_t queued_ = 0;                     /**< Tasks waiting in deques and not reserved by a worker. */
+    std::atomic<std::size_t> pending_{0};        /**< Tasks submitted and not yet finished. */
+    std::atomic<std::size_t> next_{0};           /**< Round-robin counter for external submissions. */
+    bool stop_ = false;                          /**< Set when workers must exit. */
+
+    /** @brief Executor owning the current thread (nullptr outside workers). */
+    static const WorkStealingExecutor*& current_owner() {
+        static thread_local const WorkStealingExecutor* owner = nullptr;
+        return owner;
+    }
+
+    /** @brief Worker index of the current thread. */
+    static std::size_t& current_worker() {
+        static thread_local std::size_t index = 0;
+        return index;
+    }
+
+    /**
+     * @brief Takes a task from the own deque, or steals one from another worker.
+     *
+     * @param self Worker index.
+     * @param task Taken task.
+     * @return true if a task was taken.
+     */
+    bool take(std::size_t self, Task& task) {
+        for (std::size_t k = 0; k < queues_.size(); ++k) {
+            const std::size_t i = (self + k) % queues_.size();
+            Queue& queue = *queues_[i];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            if (i == self) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Worker loop.
+     *
+     * @param self Worker index.
+     */
+    void work(std::size_t self) {
+        current_owner() = this;
+        current_worker() = self;
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+                if (queued_ == 0)
+                    return;
+                --queued_;
+            }
+
+            // A reservation was taken above and tasks are pushed before queued_ grows,
+            // so some deque is guaranteed to hold a task for this worker.
+            Task task;
+            while (!take(self, task)) {
+            }
+
+            task();
+
+            if (pending_.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_cv_.notify_all();
+            }
+        }
+    }
+};
+
+/**
+ * @class RoutedStreamBuf
+ * @brief Stream buffer that sends output to a per-thread capture buffer.
+ *
+ * While installed (for example as std::cout's buffer), every thread that has
+ * set a capture target writes into it; other threads write to the fallback
+ * buffer. This keeps output of concurrent tasks separate without changing
+ * handler code. Handlers must not change formatting flags of the shared
+ * stream while tasks run in parallel.
+ */
+class RoutedStreamBuf : public std::streambuf {
+   public:
+    /**
+     * @brief Constructs the routing buffer.
+     *
+     * @param fallback Buffer used by threads without a capture target.
+     */
+    explicit RoutedStreamBuf(std::streambuf* fallback) : fallback_(fallback) {}
+
+    /**
+     * @brief Returns the capture target of the calling thread.
+     *
+     * @return Reference to the thread-local target (nullptr to write to the fallback).
+     */
+    static std::string*& target() {
+        static thread_local std::string* current = nullptr;
+        return current;
+    }
+
+   protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+            return traits_type::not_eof(ch);
+        const char c = traits_type::to_char_type(ch);
+        if (std::string* out = target()) {
+            out->push_back(c);
+            return ch;
+        }
+        return fallback_->sputc(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        if (std::string* out = target()) {
+            out->append(s, static_cast<std::size_t>(n));
+            return n;
+        }
+        return fallback_->sputn(s, n);
+    }
+
+    int sync() override { return target() ? 0 : fallback_->pubsync(); }
+
+   private:
+    std::streambuf* fallback_; /**< Buffer for threads without a capture target. */
+};
+
+}  // namespace Clixxi
@@ -0,0 +1,162 @@
+/**
+ * @file fd_stream.hpp
+ * @brief Provides a buffered std::streambuf over a POSIX file descriptor.
+ *
+ * FdStreamBuf lets framework code reuse iostream-based paths (for example
+ * App::serve()) on sockets and pipes. It is available only on POSIX systems.
+ *
+ * Writes to a socket whose peer has gone away fail with EPIPE instead of
+ * raising SIGPIPE, so a disconnecting client cannot kill a server process.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+
+#ifdef CLIXXI_HAS_POSIX
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <streambuf>
+#include <vector>
+
+namespace Clixxi {
+
+#ifdef MSG_NOSIGNAL
+inline constexpr int fd_send_flags = MSG_NOSIGNAL; /**< send() flags that suppress SIGPIPE. */
+#else
+inline constexpr int fd_send_flags = 0; /**< No MSG_NOSIGNAL: SIGPIPE is suppressed with SO_NOSIGPIPE. */
+#endif
+
+/**
+ * @brief Stops writes to a socket from raising SIGPIPE where the platform needs a socket option for it.
+ *
+ * A no-op where send() accepts MSG_NOSIGNAL.
+ *
+ * @param fd Socket descriptor.
+ */
+inline void suppress_sigpipe(int fd) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+    (void)fd;
+#endif
+}
+
+/**
+ * @class FdStreamBuf
+ * @brief Bidirectional, buffered stream buffer over a file descriptor.
+ *
+ * The descriptor is not owned and is not closed by the stream buffer.
+ * Sockets are written with send() and MSG_NOSIGNAL, other descriptors
+ * with write(). After a write error (for example EPIPE when the peer
+ * disconnected) all further output fails, so the stream reports the
+ * error instead of blocking or retrying.
+ */
+class FdStreamBuf : public std::streambuf {
+   public:
+    /**
+     * @brief Constructs a stream buffer over a descriptor.
+     *
+     * @param fd File descriptor used for reading and writing.
+     * @param buffer_size Size of each of the input and output buffers.
+     */
+    explicit FdStreamBuf(int fd, std::size_t buffer_size = 64 * 1024) : fd_(fd), in_(buffer_size), out_(buffer_size) {
+        setg(in_.data(), in_.data(), in_.data());
+        setp(out_.data(), out_.data() + out_.size());
+    }
+
+    FdStreamBuf(const FdStreamBuf&) = delete;
+    FdStreamBuf& operator=(const FdStreamBuf&) = delete;
+
+    ~FdStreamBuf() override { sync(); }
+
+   protected:
+    /**
+     * @brief Refills the input buffer with a single read().
+     */
+    int_type underflow() override {
+        if (gptr() < egptr())
+            return traits_type::to_int_type(*gptr());
+
+        ssize_t n;
+        do {
+            n = ::read(fd_, in_.data(), in_.size());
+        } while (n < 0 && errno == EINTR);
+
+        if (n <= 0)
+            return traits_type::eof();
+        setg(in_.data(), in_.data(), in_.data() + n);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    /**
+     * @brief Flushes the output buffer when it is full.
+     */
+    int_type overflow(int_type ch) override {
+        if (flush() < 0)
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    /**
+     * @brief Writes out all buffered output.
+     */
+    int sync() override { return flush() < 0 ? -1 : 0; }
+
+   private:
+    int fd_;                /**< Underlying descriptor. */
+    std::vector<char> in_;  /**< Input buffer. */
+    std::vector<char> out_; /**< Output buffer. */
+    bool socket_ = true;    /**< Whether send() may be used (cleared on ENOTSOCK). */
+    bool failed_ = false;   /**< Set after a write error; output is discarded from then on. */
+
+    /**
+     * @brief Writes once, with send() on sockets so that a closed peer does not raise SIGPIPE.
+     */
+    ssize_t write_some(const char* data, std::size_t size) {
+        if (socket_) {
+            const ssize_t n = ::send(fd_, data, size, fd_send_flags);
+            if (n >= 0 || errno != ENOTSOCK)
+                return n;
+            socket_ = false;
+        }
+        return ::write(fd_, data, size);
+    }
+
+    /**
+     * @brief Writes the pending output, retrying on partial writes.
+     *
+     * On error the pending output is dropped and the buffer is marked as failed.
+     *
+     * @return 0 on success, -1 on error.
+     */
+    int flush() {
+        const char* data = pbase();
+        std::size_t left = static_cast<std::size_t>(pptr() - pbase());
+        while (left > 0 && !failed_) {
+            const ssize_t n = write_some(data, left);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                failed_ = true;
+                break;
+            }
+            data += n;
+            left -= static_cast<std::size_t>(n);
+        }
+        setp(out_.data(), out_.data() + out_.size());
+        return failed_ ? -1 : 0;
+    }
+};
+
+}  // namespace Clixxi
+
+#endif
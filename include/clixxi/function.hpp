@@ -0,0 +1,197 @@
+/**
+ * @file function.hpp
+ * @brief Provides a type-erased callable with inline (small-buffer) storage.
+ *
+ * SmallFunction is used for command handlers instead of std::function.
+ * Callables up to CLIXXI_HANDLER_CAPACITY bytes (most capturing lambdas)
+ * are stored inside the object, so assigning a handler does not allocate
+ * and a call is a single indirect jump into the stored callable.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @def CLIXXI_HANDLER_CAPACITY
+ * @brief Inline storage size of a command handler in bytes.
+ *
+ * Larger callables are stored on the heap.
+ */
+#ifndef CLIXXI_HANDLER_CAPACITY
+#define CLIXXI_HANDLER_CAPACITY 64
+#endif
+
+namespace Clixxi {
+
+template <typename Signature, std::size_t Capacity = CLIXXI_HANDLER_CAPACITY>
+class SmallFunction;
+
+/**
+ * @class SmallFunction
+ * @brief Copyable callable wrapper with inline storage of Capacity bytes.
+ *
+ * Behaves like std::function: it is empty by default, converts from any
+ * copyable callable with a matching signature and can be tested with
+ * operator bool. Callables that fit in the buffer and are nothrow movable
+ * are stored inline; others are stored on the heap.
+ *
+ * @tparam R Return type.
+ * @tparam Args Argument types.
+ * @tparam Capacity Inline storage size in bytes.
+ */
+template <typename R, typename... Args, std::size_t Capacity>
+class SmallFunction<R(Args...), Capacity> {
+    static_assert(Capacity >= sizeof(void*), "SmallFunction capacity must hold at least a pointer");
+
+   public:
+    SmallFunction() noexcept = default;
+    SmallFunction(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief Stores a callable.
+     *
+     * @param f Callable invocable as R(Args...).
+     */
+    template <typename F, typename D = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<D, SmallFunction> && std::is_invocable_r_v<R, D&, Args...>>>
+    SmallFunction(F&& f) {
+        static_assert(std::is_copy_constructible_v<D>, "SmallFunction requires a copyable callable");
+        // A function passed by name decays to a pointer that cannot be null.
+        if constexpr (std::is_same_v<D, std::function<R(Args...)>> || std::is_pointer_v<std::remove_reference_t<F>>) {
+            if (!f)
+                return;
+        }
+        if constexpr (fits_inline<D>()) {
+            ::new (static_cast<void*>(storage_)) D(std::forward<F>(f));
+            ops_ = &inline_ops<D>;
+        } else {
+            *reinterpret_cast<D**>(storage_) = new D(std::forward<F>(f));
+            ops_ = &heap_ops<D>;
+        }
+    }
+
+    SmallFunction(const SmallFunction& other) {
+        if (other.ops_) {
+            other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+    }
+
+    SmallFunction(SmallFunction&& other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = std::exchange(other.ops_, nullptr);
+        }
+    }
+
+    SmallFunction& operator=(const SmallFunction& other) {
+        if (this != &other) {
+            SmallFunction copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    SmallFunction& operator=(SmallFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_) {
+                other.ops_->move(storage_, other.storage_);
+                ops_ = std::exchange(other.ops_, nullptr);
+            }
+        }
+        return *this;
+    }
+
+    SmallFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~SmallFunction() { reset(); }
+
+    /** @brief Returns true if a callable is stored. */
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    /**
+     * @brief Invokes the stored callable.
+     *
+     * @throws `std::bad_function_call` - If no callable is stored.
+     */
+    R operator()(Args... args) const {
+        if (!ops_)
+            throw std::bad_function_call();
+        return ops_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+   private:
+    /**
+     * @struct Ops
+     * @brief Operations on the stored callable.
+     */
+    struct Ops {
+        R (*invoke)(void*, Args&&...);
+        void (*copy)(void*, const void*);
+        void (*move)(void*, void*) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    alignas(std::max_align_t) mutable unsigned char storage_[Capacity]; /**< Inline callable or heap pointer. */
+    const Ops* ops_ = nullptr;                                          /**< Operations (nullptr if empty). */
+
+    template <typename D>
+    static constexpr bool fits_inline() {
+        return sizeof(D) <= Capacity && alignof(std::max_align_t) % alignof(D) == 0 &&
+               std::is_nothrow_move_constructible_v<D>;
+    }
+
+    template <typename D>
+    static D& inline_target(void* storage) {
+        return *std::launder(reinterpret_cast<D*>(storage));
+    }
+
+    template <typename D>
+    static D*& heap_target(void* storage) {
+        return *std::launder(reinterpret_cast<D**>(storage));
+    }
+
+    template <typename D>
+    static constexpr Ops inline_ops = {
+        [](void* storage, Args&&... args) -> R {
+            return std::invoke(inline_target<D>(storage), std::forward<Args>(args)...);
+        },
+        [](void* dst, const void* src) { ::new (dst) D(inline_target<D>(const_cast<void*>(src))); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) D(std::move(inline_target<D>(src)));
+            inline_target<D>(src).~D();
+        },
+        [](void* storage) noexcept { inline_target<D>(storage).~D(); },
+    };
+
+    template <typename D>
+    static constexpr Ops heap_ops = {
+        [](void* storage, Args&&... args) -> R {
+            return std::invoke(*heap_target<D>(storage), std::forward<Args>(args)...);
+        },
+        [](void* dst, const void* src) {
+            *reinterpret_cast<D**>(dst) = new D(*heap_target<D>(const_cast<void*>(src)));
+        },
+        [](void* dst, void* src) noexcept { *reinterpret_cast<D**>(dst) = heap_target<D>(src); },
+        [](void* storage) noexcept { delete heap_target<D>(storage); },
+    };
+
+    /** @brief Destroys the stored callable. */
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+};
+
+}  // namespace Clixxi
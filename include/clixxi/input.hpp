@@ -0,0 +1,85 @@
+/**
+ * @file input.hpp
+ * @brief Provides streaming record readers for argument lists.
+ *
+ * Long argument lists (for example file paths from `find` or `xargs`) are
+ * often passed on stdin or in an `@response-file`. The helpers here read
+ * such input record by record, so a handler can start processing the first
+ * item before the rest of the list has arrived.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#ifdef CLIXXI_HAS_POSIX
+#include <sys/types.h>
+#endif
+
+namespace Clixxi {
+
+/**
+ * @struct InputOptions
+ * @brief Settings for Context::for_each_input().
+ */
+struct InputOptions {
+    bool response_files = true;  /**< Expand `@path` arguments to the records of the file. */
+    bool dash_is_stdin = true;   /**< Expand a `-` argument to the records of stdin. */
+    bool stdin_if_empty = false; /**< Read stdin when there are no positional arguments. */
+    char delimiter = '\n';       /**< Record separator ('\0' for `find -print0` style input). */
+};
+
+/**
+ * @brief Calls fn for every record of a stream, as soon as the record is complete.
+ *
+ * Empty records are skipped. With '\n' as delimiter a trailing '\r' is removed.
+ * The view passed to fn is valid only during the call.
+ *
+ * @tparam F Callable taking std::string_view.
+ * @param file Open input stream.
+ * @param delimiter Record separator.
+ * @param fn Record consumer.
+ */
+template <typename F>
+void for_each_record(std::FILE* file, char delimiter, F&& fn) {
+    auto emit = [&](std::string_view record) {
+        if (delimiter == '\n' && !record.empty() && record.back() == '\r')
+            record.remove_suffix(1);
+        if (!record.empty())
+            fn(record);
+    };
+
+#ifdef CLIXXI_HAS_POSIX
+    struct Line {
+        char* data = nullptr;
+        std::size_t capacity = 0;
+        ~Line() { std::free(data); }
+    } line;
+
+    ssize_t n;
+    while ((n = ::getdelim(&line.data, &line.capacity, delimiter, file)) > 0) {
+        std::string_view record(line.data, static_cast<std::size_t>(n));
+        if (record.back() == delimiter)
+            record.remove_suffix(1);
+        emit(record);
+    }
+#else
+    std::string record;
+    for (int c; (c = std::getc(file)) != EOF;) {
+        if (static_cast<char>(c) != delimiter) {
+            record.push_back(static_cast<char>(c));
+            continue;
+        }
+        emit(record);
+        record.clear();
+    }
+    emit(record);
+#endif
+}
+
+}  // namespace Clixxi
@@ -1,23 +1,228 @@
 /**
  * @file logger.hpp
  * @brief Provides a simple logging interface for Clixxi.
- * The Logger class allows logging error and warning messages.
+ * The Logger class allows logging messages with severity levels and structured fields.
  * By default, it uses ConsoleLogger to print messages to stderr with color coding.
  * Users can set a custom logger by implementing the ILogger interface and calling Logger::set_logger().
  */
 
 #pragma once
+#include <clixxi/config.hpp>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <memory>
-#include <string>
-#include <iostream>
 #include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/**
+ * @def CLIXXI_LOG_MIN_LEVEL
+ * @brief Lowest log level compiled in (0 = trace ... 4 = error, 5 = off).
+ * Calls below this level are removed at compile time.
+ */
+#ifndef CLIXXI_LOG_MIN_LEVEL
+#define CLIXXI_LOG_MIN_LEVEL 0
+#endif
 
 namespace Clixxi {
 
+/**
+ * @enum LogLevel
+ * @brief Message severity, from the most verbose to the most severe.
+ */
+enum class LogLevel { Trace = 0, Debug = 1, Info = 2, Warning = 3, Error = 4, Off = 5 };
+
+/**
+ * @brief Returns the lowercase name of a log level.
+ * @param level Log level.
+ * @return Level name.
+ */
+inline const char* level_name(LogLevel level) {
+    static constexpr const char* names[] = {"trace", "debug", "info", "warning", "error", "off"};
+    return names[static_cast<int>(level)];
+}
+
+/**
+ * @struct LogField
+ * @brief Structured key/value field attached to a log record.
+ * Created with Clixxi::field(); values are not copied, string values must outlive the call.
+ */
+struct LogField {
+    std::string_view key;                                                            /**< Field name. */
+    std::variant<std::string_view, std::int64_t, std::uint64_t, double, bool> value; /**< Field value. */
+};
+
+/**
+ * @brief Creates a structured log field.
+ * @param key Field name.
+ * @param value Field value (string, integer, floating point or bool).
+ * @return Field to pass to a Logger call.
+ */
+template <typename T>
+LogField field(std::string_view key, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return LogField{key, value};
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        return LogField{key, static_cast<std::int64_t>(value)};
+    } else if constexpr (std::is_integral_v<T>) {
+        return LogField{key, static_cast<std::uint64_t>(value)};
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return LogField{key, static_cast<double>(value)};
+    } else {
+        return LogField{key, std::string_view(value)};
+    }
+}
+
+/**
+ * @brief Appends a number to a buffer using std::to_chars.
+ * @param out Buffer.
+ * @param value Number.
+ */
+template <typename T>
+void append_number(std::string& out, T value) {
+    char digits[64];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, res.ptr);
+}
+
+/**
+ * @brief Appends structured fields as ` key=value` pairs.
+ * @param out Buffer to append to.
+ * @param fields Structured fields.
+ * @param count Number of fields.
+ */
+inline void format_fields(std::string& out, const LogField* fields, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(' ');
+        out.append(fields[i].key);
+        out.push_back('=');
+        std::visit(
+            [&out](const auto& v) {
+                using V = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<V, std::string_view>)
+                    out.append(v);
+                else if constexpr (std::is_same_v<V, bool>)
+                    out.append(v ? "true" : "false");
+                else
+                    append_number(out, v);
+            },
+            fields[i].value);
+    }
+}
+
+/**
+ * @brief Formats a record as a human-readable line: `prefix msg key=value ...\n`.
+ * The prefix is `Clixxi <level>:`, colored by severity if requested.
+ * @param out Buffer to append to.
+ * @param level Record level.
+ * @param msg Message text.
+ * @param fields Structured fields.
+ * @param count Number of fields.
+ * @param color Whether to use ANSI colors.
+ */
+inline void format_text(std::string& out, LogLevel level, std::string_view msg, const LogField* fields,
+                        std::size_t count, bool color) {
+    if (color && level == LogLevel::Error)
+        out.append("\033[1;31m");
+    else if (color && level == LogLevel::Warning)
+        out.append("\033[1;33m");
+    else if (color)
+        out.append("\033[1;36m");
+    out.append("Clixxi ").append(level_name(level)).append(":");
+    if (color)
+        out.append("\033[0m");
+    out.push_back(' ');
+    out.append(msg);
+    format_fields(out, fields, count);
+    out.push_back('\n');
+}
+
+/**
+ * @brief Appends a JSON string literal with escaping.
+ * @param out Buffer.
+ * @param str String to encode.
+ */
+inline void append_json_string(std::string& out, std::string_view str) {
+    static constexpr char hex[] = "0123456789abcdef";
+    out.push_back('"');
+    for (char c : str) {
+        switch (c) {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out.append("\\u00");
+                    out.push_back(hex[(c >> 4) & 0xF]);
+                    out.push_back(hex[c & 0xF]);
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+/**
+ * @brief Formats a record as one JSON line: `{"level":...,"msg":...,"key":value}\n`.
+ * @param out Buffer to append to.
+ * @param level Record level.
+ * @param msg Message text.
+ * @param fields Structured fields.
+ * @param count Number of fields.
+ */
+inline void format_json(std::string& out, LogLevel level, std::string_view msg, const LogField* fields,
+                        std::size_t count) {
+    out.append("{\"level\":\"").append(level_name(level)).append("\",\"msg\":");
+    append_json_string(out, msg);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(',');
+        append_json_string(out, fields[i].key);
+        out.push_back(':');
+        std::visit(
+            [&out](const auto& v) {
+                using V = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<V, std::string_view>) {
+                    append_json_string(out, v);
+                } else if constexpr (std::is_same_v<V, bool>) {
+                    out.append(v ? "true" : "false");
+                } else if constexpr (std::is_same_v<V, double>) {
+                    if (std::isfinite(v))
+                        append_number(out, v);
+                    else
+                        out.append("null");
+                } else {
+                    append_number(out, v);
+                }
+            },
+            fields[i].value);
+    }
+    out.append("}\n");
+}
+
 /**
  * @class ILogger
  * @brief Interface for logging messages in Clixxi.
- * Defines methods for logging errors and warnings.
+ * Defines methods for logging errors and warnings, and a generic leveled log() entry point.
  * Users can implement this interface to create custom loggers.
  */
 class ILogger {
@@ -25,6 +230,25 @@ class ILogger {
     virtual ~ILogger() = default;
     virtual void error(const std::string& msg) = 0;
     virtual void warning(const std::string& msg) = 0;
+
+    /**
+     * @brief Logs a leveled record with structured fields.
+     * The default implementation appends fields as `key=value` to the message and
+     * forwards errors to error() and all other levels to warning(), so loggers
+     * implementing only the two basic methods keep working.
+     * @param level Record level.
+     * @param msg Message text.
+     * @param fields Structured fields.
+     * @param count Number of fields.
+     */
+    virtual void log(LogLevel level, std::string_view msg, const LogField* fields, std::size_t count) {
+        std::string text(msg);
+        format_fields(text, fields, count);
+        if (level == LogLevel::Error)
+            error(text);
+        else
+            warning(text);
+    }
 };
 
 /**
@@ -39,60 +263,204 @@ class ConsoleLogger : public ILogger {
     * The message is prefixed with "Clixxi error:" in red.
     * @param msg The error message to log.
     */
-    void error(const std::string& msg) override { 
-        std::cerr << "\033[1;31mClixxi error:\033[0m " << msg << std::endl; 
-    }
+    void error(const std::string& msg) override { log(LogLevel::Error, msg, nullptr, 0); }
 
     /**
      * @brief Logs a warning message to stderr with color coding.
      * The message is prefixed with "Clixxi warning:" in yellow.
      * @param msg The warning message to log.
      */
-    void warning(const std::string& msg) override {
-        std::cerr << "\033[1;33mClixxi warning:\033[0m " << msg << std::endl;
+    void warning(const std::string& msg) override { log(LogLevel::Warning, msg, nullptr, 0); }
+
+    /**
+     * @brief Writes a leveled record to stderr with a single unflushed fwrite.
+     * A single write keeps lines from concurrent threads from interleaving.
+     */
+    void log(LogLevel level, std::string_view msg, const LogField* fields, std::size_t count) override {
+        static thread_local std::string line;
+        line.clear();
+        format_text(line, level, msg, fields, count, true);
+        std::fwrite(line.data(), 1, line.size(), stderr);
     }
 };
 
+/**
+ * @class JsonLogger
+ * @brief Writes records as JSON lines (one object per line) to a C stream.
+ */
+class JsonLogger : public ILogger {
+   public:
+    /**
+     * @brief Constructs a JSON logger.
+     * @param stream Destination stream (stderr by default, not closed).
+     */
+    explicit JsonLogger(std::FILE* stream = stderr) : stream_(stream) {}
+
+    void error(const std::string& msg) override { log(LogLevel::Error, msg, nullptr, 0); }
+    void warning(const std::string& msg) override { log(LogLevel::Warning, msg, nullptr, 0); }
+
+    /**
+     * @brief Writes a record as a single JSON line.
+     */
+    void log(LogLevel level, std::string_view msg, const LogField* fields, std::size_t count) override {
+        static thread_local std::string line;
+        line.clear();
+        format_json(line, level, msg, fields, count);
+        std::fwrite(line.data(), 1, line.size(), stream_);
+    }
+
+   private:
+    std::FILE* stream_; /**< Destination stream. */
+};
+
 /**
  * @class Logger
  * @brief Logger class that manages a global logger instance.
+ *
+ * Records below CLIXXI_LOG_MIN_LEVEL are removed at compile time; records
+ * below the runtime level (see set_level(), Warning by default) are dropped
+ * after a single relaxed atomic load, before any formatting happens.
+ * Use the CLIXXI_LOG_* macros to also skip evaluation of the arguments.
  */
 class Logger {
    public:
     /**
     * @brief Sets the global logger instance.
     * Users can provide their own logger by implementing ILogger and calling this method.
+    * The new logger is published atomically; previously set loggers are kept alive
+    * until program exit, because other threads may still be using them.
     * @param logger A shared pointer to the custom logger instance.
     */
-    static void set_logger(std::shared_ptr<ILogger> logger) { 
-        instance() = std::move(logger); 
+    static void set_logger(std::shared_ptr<ILogger> logger) {
+        std::lock_guard<std::mutex> lock(state().mutex);
+        ILogger* raw = logger.get();
+        if (logger)
+            state().owned.push_back(std::move(logger));
+        state().current.store(raw, std::memory_order_release);
     }
 
     /**
      * @brief Retrieves the global logger instance.
      * If no logger has been set, it initializes and returns a default ConsoleLogger.
-     * This method is thread-safe and ensures that only one instance of the logger is created.
+     * After initialization the lookup is a single lock-free atomic load.
      * @return Reference to the current ILogger instance.
      */
     static ILogger& get() {
-        static std::mutex mtx;
-        std::lock_guard<std::mutex> lock(mtx);
-        if (!instance()) {
-            instance() = create_default();
+        if (ILogger* logger = state().current.load(std::memory_order_acquire))
+            return *logger;
+        return install_default();
+    }
+
+    /**
+     * @brief Sets the runtime minimum level.
+     * @param level Records below this level are dropped.
+     */
+    static void set_level(LogLevel level) { state().level.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the runtime minimum level.
+     * @return Current level.
+     */
+    static LogLevel level() { return static_cast<LogLevel>(state().level.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Checks whether records of a level would be emitted.
+     * Constant-folds to false for levels below CLIXXI_LOG_MIN_LEVEL.
+     * @param level Record level.
+     * @return true if the level passes both compile-time and runtime filters.
+     */
+    static bool enabled(LogLevel level) {
+        return static_cast<int>(level) >= CLIXXI_LOG_MIN_LEVEL && level != LogLevel::Off &&
+               static_cast<int>(level) >= state().level.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Logs a record at a compile-time level.
+     * Parts may be strings, string views, characters, numbers or LogField
+     * values (see Clixxi::field()). Non-field parts are concatenated into a
+     * reused thread-local buffer; fields are passed to the logger as is.
+     * @tparam Level Record level.
+     * @param parts Message parts and fields.
+     */
+    template <LogLevel Level, typename... Parts>
+    static void log(const Parts&... parts) {
+        if constexpr (static_cast<int>(Level) >= CLIXXI_LOG_MIN_LEVEL) {
+            if (enabled(Level))
+                write(Level, parts...);
         }
-        return *instance();
+    }
+
+    /** @brief Logs a trace record (see log()). */
+    template <typename... Parts>
+    static void trace(const Parts&... parts) {
+        log<LogLevel::Trace>(parts...);
+    }
+
+    /** @brief Logs a debug record (see log()). */
+    template <typename... Parts>
+    static void debug(const Parts&... parts) {
+        log<LogLevel::Debug>(parts...);
+    }
+
+    /** @brief Logs an info record (see log()). */
+    template <typename... Parts>
+    static void info(const Parts&... parts) {
+        log<LogLevel::Info>(parts...);
+    }
+
+    /**
+     * @brief Logs a warning record built from several parts (see log()).
+     * @param parts Message parts and fields.
+     */
+    template <typename... Parts>
+    static void warning(const Parts&... parts) {
+        log<LogLevel::Warning>(parts...);
+    }
+
+    /**
+     * @brief Logs an error record built from several parts (see log()).
+     * @param parts Message parts and fields.
+     */
+    template <typename... Parts>
+    static void error(const Parts&... parts) {
+        log<LogLevel::Error>(parts...);
     }
 
    private:
     /**
-     * @brief Internal storage for the global logger instance.
-     * Uses a shared_ptr to allow for polymorphic loggers and easy replacement.
-     * The instance is initialized lazily when get() is called for the first time.
-     * @return Reference to the shared pointer holding the ILogger instance.
+     * @struct State
+     * @brief Global logger state.
+     */
+    struct State {
+        std::atomic<ILogger*> current{nullptr};                      /**< Published logger. */
+        std::atomic<int> level{static_cast<int>(LogLevel::Warning)}; /**< Runtime minimum level. */
+        std::mutex mutex;                                            /**< Guards owned and initialization. */
+        std::vector<std::shared_ptr<ILogger>> owned;                 /**< Loggers kept alive for readers. */
+    };
+
+    /**
+     * @brief Internal storage for the global logger state.
+     * The logger is initialized lazily when get() is called for the first time.
+     * @return Reference to the global state.
      */
-    static std::shared_ptr<ILogger>& instance() {
-        static std::shared_ptr<ILogger> logger;
-        return logger;
+    static State& state() {
+        static State instance;
+        return instance;
+    }
+
+    /**
+     * @brief Installs the default logger unless another thread already published one.
+     * @return Reference to the current ILogger instance.
+     */
+    static ILogger& install_default() {
+        std::lock_guard<std::mutex> lock(state().mutex);
+        ILogger* logger = state().current.load(std::memory_order_acquire);
+        if (!logger) {
+            state().owned.push_back(create_default());
+            logger = state().owned.back().get();
+            state().current.store(logger, std::memory_order_release);
+        }
+        return *logger;
     }
 
     /**
@@ -101,9 +469,67 @@ class Logger {
      * Users can override this method to provide a different default logger if desired.
      * @return A shared pointer to the default ILogger instance.
      */
-    static std::shared_ptr<ILogger> create_default() { 
-        return std::make_shared<ConsoleLogger>(); 
+    static std::shared_ptr<ILogger> create_default() {
+        return std::make_shared<ConsoleLogger>();
+    }
+
+    /**
+     * @brief Appends one message part to the message buffer or the field list.
+     * @param out Message buffer.
+     * @param fields Field list.
+     * @param part Message part.
+     */
+    template <typename T>
+    static void append(std::string& out, std::vector<LogField>& fields, const T& part) {
+        if constexpr (std::is_same_v<T, LogField>) {
+            fields.push_back(part);
+        } else if constexpr (std::is_same_v<T, char>) {
+            out.push_back(part);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            out.append(part ? "true" : "false");
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            append_number(out, part);
+        } else {
+            out.append(std::string_view(part));
+        }
+    }
+
+    /**
+     * @brief Formats message parts and forwards the record to the current logger.
+     * @param level Record level.
+     * @param parts Message parts and fields.
+     */
+    template <typename... Parts>
+    static void write(LogLevel level, const Parts&... parts) {
+        static thread_local std::string buffer;
+        static thread_local std::vector<LogField> field_buffer;
+        std::string msg;
+        std::vector<LogField> fields;
+        msg.swap(buffer);  // Keeps nested logging calls from clobbering the buffers.
+        fields.swap(field_buffer);
+        msg.clear();
+        fields.clear();
+        (append(msg, fields, parts), ...);
+        get().log(level, msg, fields.data(), fields.size());
+        buffer.swap(msg);
+        field_buffer.swap(fields);
     }
 };
 
-}  // namespace Clixxi
\ No newline at end of file
+}  // namespace Clixxi
+
+/**
+ * @def CLIXXI_LOG(level, ...)
+ * @brief Logs a record without evaluating the arguments when the level is filtered out.
+ */
+#define CLIXXI_LOG(level, ...)                         \
+    do {                                               \
+        if (::Clixxi::Logger::enabled(level))          \
+            ::Clixxi::Logger::log<level>(__VA_ARGS__); \
+    } while (0)
+
+#define CLIXXI_LOG_TRACE(...) CLIXXI_LOG(::Clixxi::LogLevel::Trace, __VA_ARGS__)
+#define CLIXXI_LOG_DEBUG(...) CLIXXI_LOG(::Clixxi::LogLevel::Debug, __VA_ARGS__)
+#define CLIXXI_LOG_INFO(...) CLIXXI_LOG(::Clixxi::LogLevel::Info, __VA_ARGS__)
+#define CLIXXI_LOG_WARNING(...) CLIXXI_LOG(::Clixxi::LogLevel::Warning, __VA_ARGS__)
+#define CLIXXI_LOG_ERROR(...) CLIXXI_LOG(::Clixxi::LogLevel::Error, __VA_ARGS__)
@@ -0,0 +1,119 @@
+/**
+ * @file memory.hpp
+ * @brief Provides arena allocation for per-invocation parse state.
+ *
+ * Context and OptionTable store their arrays in ArenaVector, which draws
+ * from a MemoryResource. App gives every invocation (or every batch) an
+ * Arena: a monotonic buffer on the stack that falls back to the heap only
+ * when it runs out, and releases everything at once when it goes out of scope.
+ *
+ * When the standard library lacks <memory_resource> (see CLIXXI_HAS_PMR),
+ * the same names map to the global allocator.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#ifdef CLIXXI_HAS_PMR
+#include <memory_resource>
+#endif
+
+namespace Clixxi {
+
+#ifdef CLIXXI_HAS_PMR
+
+/** @brief Source of memory for arena-backed containers. */
+using MemoryResource = std::pmr::memory_resource;
+
+/** @brief Allocator drawing from a MemoryResource. */
+template <typename T>
+using ArenaAllocator = std::pmr::polymorphic_allocator<T>;
+
+/** @brief Returns the process-wide default resource (the global heap unless changed). */
+inline MemoryResource* default_memory_resource() { return std::pmr::get_default_resource(); }
+
+/**
+ * @class Arena
+ * @brief Monotonic memory resource over an inline buffer.
+ *
+ * Allocations are carved from the buffer and never freed individually;
+ * if the buffer is exhausted, further blocks come from the heap. All memory
+ * is released when the Arena is destroyed, so containers using it must not
+ * outlive it.
+ *
+ * @tparam N Size of the inline buffer in bytes.
+ */
+template <std::size_t N>
+class Arena {
+   public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /** @brief Returns the resource to pass to arena-backed containers. */
+    MemoryResource* resource() { return &resource_; }
+
+   private:
+    /** @brief Inline storage. */
+    alignas(std::max_align_t) std::byte buffer_[N];
+
+    /** @brief Resource carving buffer_, then heap blocks. */
+    std::pmr::monotonic_buffer_resource resource_{buffer_, N, std::pmr::new_delete_resource()};
+};
+
+#else
+
+/** @brief Placeholder resource type (allocation falls back to the global heap). */
+struct MemoryResource {};
+
+/**
+ * @brief Global-heap allocator accepting (and ignoring) a MemoryResource.
+ */
+template <typename T>
+struct ArenaAllocator : std::allocator<T> {
+    template <typename U>
+    struct rebind {
+        using other = ArenaAllocator<U>;
+    };
+
+    ArenaAllocator(MemoryResource* = nullptr) noexcept {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&) noexcept {
+    return false;
+}
+
+/** @brief Returns nullptr (no resources without <memory_resource>). */
+inline MemoryResource* default_memory_resource() { return nullptr; }
+
+/**
+ * @brief No-op arena used without <memory_resource>.
+ */
+template <std::size_t N>
+class Arena {
+   public:
+    /** @brief Returns nullptr (containers use the global heap). */
+    MemoryResource* resource() { return nullptr; }
+};
+
+#endif
+
+/** @brief Vector drawing from a MemoryResource. */
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace Clixxi
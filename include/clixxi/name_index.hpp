@@ -0,0 +1,184 @@
+/**
+ * @file name_index.hpp
+ * @brief Defines a frozen character trie over a sorted set of names.
+ *
+ * NameIndex is built once from a sorted list of names (for example,
+ * registered command names) and then resolves exact lookups in
+ * O(length of name) and prefix queries in O(length of prefix).
+ * Because the source names are sorted, every trie node covers a
+ * contiguous range of them, so completion candidates are returned
+ * as a range without scanning the whole set.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Clixxi {
+
+/**
+ * @class NameIndex
+ * @brief Character trie with contiguous sibling storage.
+ *
+ * There is one node per distinct name prefix (one character per edge);
+ * single-child chains are not path-compressed. Nodes are laid out
+ * breadth-first in one array, so the children of each node occupy a
+ * contiguous, label-sorted slice of it. The index does not own the
+ * names: they must outlive it.
+ *
+ * Example:
+ * @code
+ * Clixxi::NameIndex index;
+ * index.build({"build", "bump", "status"});
+ * index.find("bump");             // 1
+ * index.prefix_range("bu");       // {0, 2}
+ * @endcode
+ */
+class NameIndex {
+   public:
+    /** @brief Value returned when a name is not found. */
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Builds the index from names sorted in ascending order.
+     *
+     * Duplicate names are not allowed.
+     *
+     * @param names Sorted names (views must outlive the index).
+     */
+    void build(std::vector<std::string_view> names) {
+        names_ = std::move(names);
+        nodes_.clear();
+        nodes_.push_back(Node{0, 0, '\0', npos32, 0, static_cast<std::uint32_t>(names_.size())});
+
+        for (std::size_t n = 0, depth_end = 1, depth = 0; n < nodes_.size(); ++n) {
+            if (n == depth_end) {
+                ++depth;
+                depth_end = nodes_.size();
+            }
+            std::uint32_t lo = nodes_[n].lo;
+            const std::uint32_t hi = nodes_[n].hi;
+
+            if (lo < hi && names_[lo].size() == depth) {
+                nodes_[n].value = lo;
+                ++lo;
+            }
+
+            nodes_[n].first_child = static_cast<std::uint32_t>(nodes_.size());
+            while (lo < hi) {
+                const char label = names_[lo][depth];
+                std::uint32_t end = lo + 1;
+                while (end < hi && names_[end][depth] == label)
+                    ++end;
+                nodes_.push_back(Node{0, 0, label, npos32, lo, end});
+                ++nodes_[n].child_count;
+                lo = end;
+            }
+        }
+        built_ = true;
+    }
+
+    /** @brief Drops the index; built() returns false afterwards. */
+    void clear() {
+        names_.clear();
+        nodes_.clear();
+        built_ = false;
+    }
+
+    /** @brief Returns true once build() has been called. */
+    bool built() const { return built_; }
+
+    /** @brief Returns the number of indexed names. */
+    std::size_t size() const { return names_.size(); }
+
+    /**
+     * @brief Returns the indexed name at position i (in sorted order).
+     *
+     * @param i Position of the name.
+     * @return Indexed name.
+     */
+    std::string_view name(std::size_t i) const { return names_[i]; }
+
+    /**
+     * @brief Resolves a name to its position in the sorted list.
+     *
+     * @param name Name to look up.
+     * @return Position of the name, or npos if it is not indexed.
+     */
+    std::size_t find(std::string_view name) const {
+        const std::size_t node = descend(name);
+        if (node == npos || nodes_[node].value == npos32)
+            return npos;
+        return nodes_[node].value;
+    }
+
+    /**
+     * @brief Returns the range of names starting with a prefix.
+     *
+     * @param prefix Name prefix (may be empty).
+     * @return Half-open range [first, second) of positions; empty if none match.
+     */
+    std::pair<std::size_t, std::size_t> prefix_range(std::string_view prefix) const {
+        const std::size_t node = descend(prefix);
+        if (node == npos)
+            return {0, 0};
+        return {nodes_[node].lo, nodes_[node].hi};
+    }
+
+   private:
+    static constexpr std::uint32_t npos32 = 0xFFFFFFFFu;
+
+    /**
+     * @struct Node
+     * @brief Single trie node.
+     */
+    struct Node {
+        std::uint32_t first_child; /**< Position of the first child in nodes_. */
+        std::uint32_t child_count; /**< Number of children. */
+        char label;                /**< Character on the edge leading to this node. */
+        std::uint32_t value;       /**< Position of the name ending here, or npos32. */
+        std::uint32_t lo;          /**< First name covered by this subtree. */
+        std::uint32_t hi;          /**< Past-the-last name covered by this subtree. */
+    };
+
+    std::vector<std::string_view> names_; /**< Indexed names in sorted order. */
+    std::vector<Node> nodes_;             /**< Trie nodes in breadth-first order. */
+    bool built_ = false;                  /**< Whether build() has been called. */
+
+    /**
+     * @brief Walks the trie along a string.
+     *
+     * @param str Path to follow.
+     * @return Node reached, or npos if the path does not exist.
+     */
+    std::size_t descend(std::string_view str) const {
+        if (nodes_.empty())
+            return npos;
+
+        std::size_t node = 0;
+        for (char c : str) {
+            const Node& current = nodes_[node];
+            std::size_t lo = current.first_child, hi = lo + current.child_count;
+            const auto key = static_cast<unsigned char>(c);
+
+            while (lo < hi) {
+                const std::size_t mid = (lo + hi) / 2;
+                const auto label = static_cast<unsigned char>(nodes_[mid].label);
+                if (label < key)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            if (lo == current.first_child + current.child_count || nodes_[lo].label != c)
+                return npos;
+            node = lo;
+        }
+        return node;
+    }
+};
+
+}  // namespace Clixxi
@@ -9,11 +9,25 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <type_traits>
 #include <variant>
 
 namespace Clixxi {
 
+/**
+ * @struct ByteSize
+ * @brief Option value type for byte sizes with unit suffixes (`64MiB`, `10MB`).
+ */
+struct ByteSize {
+    std::uint64_t bytes = 0; /**< Size in bytes. */
+
+    /** @brief Compares two byte sizes. */
+    bool operator==(const ByteSize& other) const { return bytes == other.bytes; }
+};
+
 /**
  * @typedef OptionType
  * @brief Variant type representing supported option value types.
@@ -23,10 +37,33 @@ namespace Clixxi {
  * - int
  * - float
  * - std::string
+ * - std::int64_t
+ * - std::uint64_t (also std::size_t on 64-bit platforms)
+ * - double
+ * - ByteSize
+ * - std::chrono::nanoseconds
+ *
+ * Schema stores converted option values in OptionType slots,
+ * so each value is parsed only once per execution.
+ */
+using OptionType = std::variant<bool, int, float, std::string, std::int64_t, std::uint64_t, double, ByteSize,
+                                std::chrono::nanoseconds>;
+
+/**
+ * @brief Checks whether T is one of the OptionType alternatives.
  *
- * This type can be used to store or represent parsed option values.
+ * @tparam T Type to check.
+ * @tparam K Alternative index to start from.
+ * @return true if OptionType can hold T.
  */
-using OptionType = std::variant<bool, int, float, std::string>;
+template <typename T, std::size_t K = 0>
+constexpr bool is_option_type() {
+    if constexpr (K == std::variant_size_v<OptionType>) {
+        return false;
+    } else {
+        return std::is_same_v<T, std::variant_alternative_t<K, OptionType>> || is_option_type<T, K + 1>();
+    }
+}
 
 /**
  * @struct Option
@@ -40,12 +77,14 @@ struct Option {
      * @brief Constructs an option definition.
      * @param name Name of the option (without leading dashes).
      * @param desc Human-readable description of the option.
+     * @param env Environment variable used when the option is not given (empty for none).
      */
-    explicit Option(const std::string& name, const std::string& desc = "no desc")
-        : option_name_(name), option_desc_(desc) {}
+    explicit Option(const std::string& name, const std::string& desc = "no desc", const std::string& env = "")
+        : option_name_(name), option_desc_(desc), option_env_(env) {}
         
     std::string option_name_; /**< Option identifier. */
     std::string option_desc_; /**< Option description text. */
+    std::string option_env_;  /**< Fallback environment variable name. */
 };
 
 }  // namespace Clixxi
\ No newline at end of file
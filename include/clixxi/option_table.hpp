@@ -0,0 +1,253 @@
+/**
+ * @file option_table.hpp
+ * @brief Defines a flat, cache-friendly storage for parsed option values.
+ *
+ * OptionTable replaces node-based maps for parsed options. Entries are kept
+ * in contiguous arrays and looked up by a precomputed hash, so lookups never
+ * allocate and small option sets fit in one or two cache lines.
+ */
+
+#pragma once
+
+#include <clixxi/memory.hpp>
+#include <clixxi/option.hpp>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Clixxi {
+
+/**
+ * @brief Computes a 32-bit FNV-1a hash of a string.
+ *
+ * The function is constexpr, so hashes of string literals can be folded at compile time.
+ *
+ * @param str String to hash.
+ * @return Hash value.
+ */
+constexpr std::uint32_t hash_name(std::string_view str) {
+    std::uint32_t hash = 2166136261u;
+    for (char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @class OptionTable
+ * @brief Flat key-value table for parsed options.
+ *
+ * Storage layout:
+ * - hashes are stored in a separate contiguous array, so a linear scan
+ *   over a small table touches only one or two cache lines;
+ * - keys and values are stored as string views in insertion order;
+ * - once the table grows beyond a small threshold, an open-addressing index
+ *   is built to keep lookups O(1).
+ *
+ * Each entry also carries a cached converted value (see Context::get_option).
+ * The table does not own the viewed strings. Its arrays may be drawn from
+ * a MemoryResource, such as the Arena of one invocation.
+ */
+class OptionTable {
+   public:
+    /**
+     * @struct Entry
+     * @brief Single stored key-value pair.
+     */
+    struct Entry {
+        std::string_view key;        /**< Option name (without leading dashes). */
+        std::string_view value;      /**< Raw option value. */
+        mutable OptionType cache{};  /**< Last converted value (valid if cached is set). */
+        mutable bool cached = false; /**< Whether cache holds a converted value. */
+    };
+
+    /**
+     * @brief Constructs an empty table.
+     *
+     * @param resource Memory resource for the table arrays.
+     */
+    explicit OptionTable(MemoryResource* resource = default_memory_resource())
+        : hashes_(resource), entries_(resource), index_(resource) {}
+
+    /**
+     * @brief Reserves storage for the expected number of entries.
+     *
+     * @param count Expected number of entries.
+     */
+    void reserve(std::size_t count) {
+        hashes_.reserve(count);
+        entries_.reserve(count);
+    }
+
+    /**
+     * @brief Inserts a key-value pair if the key is not present yet.
+     *
+     * @param key Option name.
+     * @param value Option value.
+     * @return true if inserted, false if the key already existed.
+     */
+    bool emplace(std::string_view key, std::string_view value) { return emplace(key, value, hash_name(key)); }
+
+    /**
+     * @brief Inserts a key-value pair with a precomputed hash if the key is not present yet.
+     *
+     * @param key Option name.
+     * @param value Option value.
+     * @param hash Value of hash_name(key).
+     * @return true if inserted, false if the key already existed.
+     */
+    bool emplace(std::string_view key, std::string_view value, std::uint32_t hash) {
+        bool inserted;
+        insert(key, value, hash, inserted);
+        return inserted;
+    }
+
+    /**
+     * @brief Inserts a key-value pair if the key is not present yet and returns its position.
+     *
+     * @param key Option name.
+     * @param value Option value.
+     * @param hash Value of hash_name(key).
+     * @param inserted Set to true if inserted, false if the key already existed.
+     * @return Position of the entry for key in insertion order.
+     */
+    std::size_t insert(std::string_view key, std::string_view value, std::uint32_t hash, bool& inserted) {
+        const std::size_t existing = find_index(key, hash);
+        inserted = existing == npos;
+        if (!inserted)
+            return existing;
+
+        hashes_.push_back(hash);
+        entries_.push_back(Entry{key, value, {}, false});
+
+        if (entries_.size() > linear_limit) {
+            if (index_.size() < entries_.size() * 2)
+                rebuild_index();
+            else
+                insert_index(static_cast<std::uint32_t>(entries_.size() - 1));
+        }
+        return entries_.size() - 1;
+    }
+
+    /**
+     * @brief Inserts a key-value pair, replacing the value if the key exists.
+     *
+     * @param key Option name.
+     * @param value Option value.
+     */
+    void assign(std::string_view key, std::string_view value) {
+        const std::size_t i = find_index(key, hash_name(key));
+        if (i == npos) {
+            emplace(key, value);
+            return;
+        }
+        entries_[i].value = value;
+        entries_[i].cached = false;
+    }
+
+    /**
+     * @brief Finds an entry by key.
+     *
+     * @param key Option name.
+     * @return Pointer to the entry, or nullptr if not found.
+     */
+    const Entry* find(std::string_view key) const { return find(key, hash_name(key)); }
+
+    /**
+     * @brief Finds an entry by key with a precomputed hash.
+     *
+     * @param key Option name.
+     * @param hash Value of hash_name(key).
+     * @return Pointer to the entry, or nullptr if not found.
+     */
+    const Entry* find(std::string_view key, std::uint32_t hash) const {
+        const std::size_t i = find_index(key, hash);
+        return i == npos ? nullptr : &entries_[i];
+    }
+
+    /**
+     * @brief Checks whether a key is present.
+     *
+     * @param key Option name.
+     * @return true if the key exists.
+     */
+    bool contains(std::string_view key) const { return find(key) != nullptr; }
+
+    /** @brief Returns the number of stored entries. */
+    std::size_t size() const { return entries_.size(); }
+
+    /** @brief Returns true if no entries are stored. */
+    bool empty() const { return entries_.empty(); }
+
+    /** @brief Returns the entry at a position (insertion order). */
+    const Entry& operator[](std::size_t i) const { return entries_[i]; }
+
+    /** @brief Returns an iterator to the first entry (insertion order). */
+    ArenaVector<Entry>::const_iterator begin() const { return entries_.begin(); }
+
+    /** @brief Returns an iterator past the last entry. */
+    ArenaVector<Entry>::const_iterator end() const { return entries_.end(); }
+
+   private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t linear_limit = 16; /**< Entries scanned linearly before indexing. */
+    static constexpr std::uint32_t empty_slot = 0xFFFFFFFFu;
+
+    ArenaVector<std::uint32_t> hashes_; /**< Precomputed key hashes, parallel to entries_. */
+    ArenaVector<Entry> entries_;        /**< Stored entries in insertion order. */
+    ArenaVector<std::uint32_t> index_;  /**< Open-addressing index into entries_ (power of two size). */
+
+    /**
+     * @brief Locates the position of a key in entries_.
+     *
+     * @param key Option name.
+     * @param hash Value of hash_name(key).
+     * @return Index into entries_, or npos if not found.
+     */
+    std::size_t find_index(std::string_view key, std::uint32_t hash) const {
+        if (index_.empty()) {
+            for (std::size_t i = 0; i < hashes_.size(); ++i) {
+                if (hashes_[i] == hash && entries_[i].key == key)
+                    return i;
+            }
+            return npos;
+        }
+
+        const std::size_t mask = index_.size() - 1;
+        for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            const std::uint32_t i = index_[slot];
+            if (i == empty_slot)
+                return npos;
+            if (hashes_[i] == hash && entries_[i].key == key)
+                return i;
+        }
+    }
+
+    /**
+     * @brief Inserts an entry position into the open-addressing index.
+     *
+     * @param i Index into entries_.
+     */
+    void insert_index(std::uint32_t i) {
+        const std::size_t mask = index_.size() - 1;
+        std::size_t slot = hashes_[i] & mask;
+        while (index_[slot] != empty_slot)
+            slot = (slot + 1) & mask;
+        index_[slot] = i;
+    }
+
+    /**
+     * @brief Rebuilds the open-addressing index with a load factor of at most 1/2.
+     */
+    void rebuild_index() {
+        std::size_t capacity = 64;
+        while (capacity < entries_.size() * 4)
+            capacity *= 2;
+        index_.assign(capacity, empty_slot);
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+            insert_index(static_cast<std::uint32_t>(i));
+    }
+};
+
+}  // namespace Clixxi
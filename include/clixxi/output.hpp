@@ -0,0 +1,231 @@
+/**
+ * @file output.hpp
+ * @brief Provides a buffered, iostream-free output sink for handlers.
+ *
+ * Output collects text in a large buffer and hands it to the destination
+ * in as few writes as possible: sputn() on a stream buffer (std::cout's by
+ * default), or write() on a file descriptor. Handlers reach the sink of the running command
+ * through Context::out(); the framework flushes it when the command exits.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#ifdef CLIXXI_HAS_POSIX
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace Clixxi {
+
+/**
+ * @class Output
+ * @brief Buffered writer over a file descriptor or a stream buffer.
+ *
+ * Writes smaller than the buffer are copied into it; larger writes flush
+ * the buffer and go to the destination directly, without a copy.
+ * Nothing is written until the buffer fills or flush() is called.
+ *
+ * Example:
+ * @code
+ * app.command("list").run([](const Clixxi::Context& ctx) {
+ *     for (int i = 0; i < 1000000; ++i)
+ *         ctx.out() << "item " << i << '\n';
+ * });
+ * @endcode
+ *
+ * Output is not synchronized. The default sink of each thread writes to
+ * the stream buffer std::cout has at the time of the flush, so it follows
+ * rdbuf() redirection and stays ordered with std::cout text already written;
+ * text written to std::cout in between flushes is not ordered against
+ * buffered Output text. Writing straight to file descriptor 1 skips the
+ * stream buffer and is opt-in:
+ * @code
+ * Clixxi::Output direct(1);
+ * Clixxi::Output::installed() = &direct;
+ * @endcode
+ */
+class Output {
+   public:
+    /** @brief Default buffer size in bytes. */
+    static constexpr std::size_t default_capacity = 64 * 1024;
+
+    /** @brief Constructs a sink writing to std::cout's current stream buffer. */
+    Output() : buffer_(default_capacity) {}
+
+    /**
+     * @brief Constructs a sink writing to a file descriptor.
+     *
+     * Without POSIX support only 1 (stdout) and 2 (stderr) are recognized.
+     *
+     * @param fd Destination descriptor (not closed by the sink).
+     * @param capacity Buffer size in bytes.
+     */
+    explicit Output(int fd, std::size_t capacity = default_capacity) : fd_(fd), buffer_(capacity ? capacity : 1) {}
+
+    /**
+     * @brief Constructs a sink writing to a stream buffer.
+     *
+     * @param sink Destination stream buffer (not owned).
+     * @param capacity Buffer size in bytes.
+     */
+    explicit Output(std::streambuf* sink, std::size_t capacity = default_capacity)
+        : sink_(sink), buffer_(capacity ? capacity : 1) {}
+
+    Output(const Output&) = delete;
+    Output& operator=(const Output&) = delete;
+
+    /** @brief Flushes the remaining buffered text. */
+    ~Output() { flush(); }
+
+    /**
+     * @brief Returns the sink of the calling thread.
+     *
+     * This is the sink installed by the framework for the running command
+     * (see installed()), or a per-thread sink over std::cout's stream buffer.
+     */
+    static Output& current() {
+        if (Output* output = installed())
+            return *output;
+        static thread_local Output standard;
+        return standard;
+    }
+
+    /**
+     * @brief Returns the sink installed for the calling thread.
+     *
+     * @return Reference to the thread-local pointer (nullptr selects the standard sink).
+     */
+    static Output*& installed() {
+        static thread_local Output* output = nullptr;
+        return output;
+    }
+
+    /**
+     * @brief Appends text.
+     *
+     * @param text Text to write.
+     * @return *this.
+     */
+    Output& write(std::string_view text) {
+        if (text.size() > buffer_.size() - size_) {
+            flush();
+            if (text.size() >= buffer_.size()) {
+                emit(text.data(), text.size());
+                return *this;
+            }
+        }
+        std::memcpy(buffer_.data() + size_, text.data(), text.size());
+        size_ += text.size();
+        return *this;
+    }
+
+    /**
+     * @brief Appends a single character.
+     *
+     * @param c Character to write.
+     * @return *this.
+     */
+    Output& put(char c) {
+        if (size_ == buffer_.size())
+            flush();
+        buffer_[size_++] = c;
+        return *this;
+    }
+
+    /** @brief Appends text. */
+    Output& operator<<(std::string_view text) { return write(text); }
+
+    /** @brief Appends a null-terminated string. */
+    Output& operator<<(const char* text) { return write(text); }
+
+    /** @brief Appends a character. */
+    Output& operator<<(char c) { return put(c); }
+
+    /** @brief Appends "true" or "false". */
+    Output& operator<<(bool value) { return write(value ? "true" : "false"); }
+
+    /**
+     * @brief Appends a number in its shortest decimal form.
+     *
+     * @tparam T Integral or floating point type.
+     * @param value Number to write.
+     * @return *this.
+     */
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                                               !std::is_same_v<T, char>,
+                                           int> = 0>
+    Output& operator<<(T value) {
+        char digits[64];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return write(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+    }
+
+    /**
+     * @brief Writes all buffered text to the destination.
+     *
+     * @return false if the destination reported an error.
+     */
+    bool flush() {
+        if (size_ == 0)
+            return true;
+        const std::size_t size = size_;
+        size_ = 0;
+        return emit(buffer_.data(), size);
+    }
+
+    /** @brief Returns the number of bytes waiting in the buffer. */
+    std::size_t buffered() const { return size_; }
+
+   private:
+    int fd_ = -1;                    /**< Destination descriptor (-1 for std::cout). */
+    std::streambuf* sink_ = nullptr; /**< Destination stream buffer (null for a descriptor or std::cout). */
+    std::vector<char> buffer_;       /**< Pending text storage. */
+    std::size_t size_ = 0;           /**< Bytes used in buffer_. */
+
+    /**
+     * @brief Writes a block to the destination, retrying on partial writes.
+     *
+     * @return false on error.
+     */
+    bool emit(const char* data, std::size_t size) {
+        std::streambuf* sink = sink_ || fd_ >= 0 ? sink_ : std::cout.rdbuf();
+        if (sink)
+            return sink->sputn(data, static_cast<std::streamsize>(size)) == static_cast<std::streamsize>(size);
+        if (fd_ < 0)
+            return false;  // std::cout without a stream buffer.
+
+        // Keep text already written through stdio ahead of ours.
+        std::fflush(fd_ == 2 ? stderr : stdout);
+#ifdef CLIXXI_HAS_POSIX
+        while (size > 0) {
+            const ssize_t n = ::write(fd_, data, size);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+#else
+        std::FILE* file = fd_ == 2 ? stderr : stdout;
+        return std::fwrite(data, 1, size, file) == size && std::fflush(file) == 0;
+#endif
+    }
+};
+
+}  // namespace Clixxi
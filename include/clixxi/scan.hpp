@@ -0,0 +1,107 @@
+/**
+ * @file scan.hpp
+ * @brief Provides vectorized byte-set search used by the tokenizers.
+ *
+ * find_any() classifies 16 or 32 bytes per step with SSE2, AVX2 or NEON
+ * compares (see CLIXXI_SIMD_AVX2) and falls back to a scalar loop for the
+ * tail and on other targets. Callers copy the run of ordinary bytes in one
+ * go and only branch on the special byte that ends it.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+
+#include <cstdint>
+
+#if defined(CLIXXI_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(CLIXXI_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(CLIXXI_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Clixxi {
+
+namespace detail {
+
+/** @brief Returns the index of the lowest set bit of a non-zero mask. */
+inline unsigned lowest_bit(std::uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief Finds the first byte equal to any of Set.
+ *
+ * Example:
+ * @code
+ * const char* space = Clixxi::find_any<' ', '\t'>(line.data(), line.data() + line.size());
+ * @endcode
+ *
+ * @tparam Set Bytes to search for.
+ * @param first Start of the range.
+ * @param last End of the range.
+ * @return Pointer to the first matching byte, or last if there is none.
+ */
+template <char... Set>
+inline const char* find_any(const char* first, const char* last) {
+    static_assert(sizeof...(Set) > 0, "find_any requires at least one byte");
+
+#if defined(CLIXXI_SIMD_AVX2)
+    while (last - first >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i hits = _mm256_setzero_si256();
+        ((hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(Set)))), ...);
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0)
+            return first + detail::lowest_bit(mask);
+        first += 32;
+    }
+#endif
+
+#if defined(CLIXXI_SIMD_AVX2) || defined(CLIXXI_SIMD_SSE2)
+    while (last - first >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i hits = _mm_setzero_si128();
+        ((hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8(Set)))), ...);
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0)
+            return first + detail::lowest_bit(mask);
+        first += 16;
+    }
+#elif defined(CLIXXI_SIMD_NEON)
+    while (last - first >= 16) {
+        const uint8x16_t block = vld1q_u8(reinterpret_cast<const std::uint8_t*>(first));
+        uint8x16_t hits = vdupq_n_u8(0);
+        ((hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8(static_cast<std::uint8_t>(Set))))), ...);
+        // Narrow every byte of the compare result to 4 bits of a 64-bit mask.
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(hits), 4);
+        const std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+        if (mask != 0)
+            return first + (detail::lowest_bit(mask) >> 2);
+        first += 16;
+    }
+#endif
+
+    for (; first != last; ++first) {
+        const char c = *first;
+        if (((c == Set) || ...))
+            return first;
+    }
+    return last;
+}
+
+}  // namespace Clixxi
@@ -0,0 +1,202 @@
+/**
+ * @file schema.hpp
+ * @brief Provides a compile-time option schema with typed, index-based access.
+ *
+ * A Schema declares the options of a command together with their types.
+ * Values are converted exactly once, when the schema is built from a Context,
+ * and stored in OptionType slots. Handlers then read them by compile-time
+ * index or name without any string lookup or reparsing.
+ */
+
+#pragma once
+
+#include <clixxi/context.hpp>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace Clixxi {
+
+/**
+ * @struct opt
+ * @brief Compile-time descriptor of a typed option.
+ *
+ * C++17 does not allow string literals as template arguments, so the name
+ * (and the optional description) must be a constexpr character array.
+ *
+ * Example:
+ * @code
+ * static constexpr char threads[] = "threads";
+ * using WorkOptions = Clixxi::Schema<Clixxi::opt<threads, int>>;
+ * @endcode
+ *
+ * @tparam Name Option name (without leading dashes).
+ * @tparam T Option value type, must be one of the OptionType alternatives.
+ * @tparam Desc Optional option description.
+ */
+template <const char* Name, typename T, const char* Desc = nullptr>
+struct opt {
+    using type = T;                                  /**< Option value type. */
+    static constexpr const char* name = Name;        /**< Option name. */
+    static constexpr const char* description = Desc; /**< Option description (may be nullptr). */
+};
+
+/**
+ * @class Schema
+ * @brief Typed option values of a command, converted once from a Context.
+ *
+ * Example:
+ * @code
+ * static constexpr char a[] = "a";
+ * static constexpr char b[] = "b";
+ * using SumOptions = Clixxi::Schema<Clixxi::opt<a, int>, Clixxi::opt<b, int>>;
+ *
+ * app.command("sum")
+ *     .run<SumOptions>([](const Clixxi::Context& ctx, const SumOptions& opts) {
+ *         std::cout << opts.get<0>() + opts.get<b>() << std::endl;
+ *     });
+ * @endcode
+ *
+ * Missing `bool` options are treated as false. Missing options of other
+ * types throw MissingRequiredOptionException when they are read.
+ *
+ * @tparam Opts List of opt descriptors.
+ */
+template <typename... Opts>
+class Schema {
+   public:
+    /** @brief Number of declared options. */
+    static constexpr std::size_t size = sizeof...(Opts);
+
+    /** @brief Value type of the option at index I. */
+    template <std::size_t I>
+    using type_at = typename std::tuple_element_t<I, std::tuple<Opts...>>::type;
+
+    /**
+     * @brief Returns the compile-time index of an option by name.
+     *
+     * @tparam Name Option name.
+     * @return Index of the option, or size if not declared.
+     */
+    template <const char* Name>
+    static constexpr std::size_t index_of() {
+        constexpr const char* names[] = {Opts::name..., nullptr};
+        for (std::size_t i = 0; i < size; ++i) {
+            if (std::string_view(names[i]) == std::string_view(Name))
+                return i;
+        }
+        return size;
+    }
+
+    /**
+     * @brief Returns the name of the option at index i.
+     *
+     * @param i Option index.
+     * @return Option name.
+     */
+    static constexpr std::string_view name_at(std::size_t i) {
+        constexpr const char* names[] = {Opts::name..., nullptr};
+        return names[i];
+    }
+
+    /**
+     * @brief Invokes a callable with the name and description of each declared option.
+     *
+     * @param fn Callable taking (const char* name, const char* desc); desc may be nullptr.
+     */
+    template <typename F>
+    static void for_each_option(F&& fn) {
+        (fn(Opts::name, Opts::description), ...);
+    }
+
+    /**
+     * @brief Converts all declared options from a Context.
+     *
+     * Every option is looked up and converted exactly once.
+     *
+     * @param ctx Parsed execution context.
+     *
+     * @throws `BadOptionTypeException` - If a provided value cannot be converted.
+     */
+    explicit Schema(const Context& ctx) { load(ctx, std::index_sequence_for<Opts...>{}); }
+
+    /**
+     * @brief Returns the value of the option at index I.
+     *
+     * @tparam I Option index.
+     * @return Reference to the converted value.
+     *
+     * @throws `MissingRequiredOptionException` - If the option was not provided and is not bool.
+     */
+    template <std::size_t I>
+    const type_at<I>& get() const {
+        static_assert(I < size, "Option index out of range");
+        if (!present_[I])
+            throw MissingRequiredOptionException(std::string(name_at(I)));
+        return std::get<type_at<I>>(slots_[I]);
+    }
+
+    /**
+     * @brief Returns the value of an option by compile-time name.
+     *
+     * @tparam Name Option name.
+     * @return Reference to the converted value.
+     */
+    template <const char* Name>
+    const auto& get() const {
+        constexpr std::size_t index = index_of<Name>();
+        static_assert(index < size, "Option is not declared in schema");
+        return get<index>();
+    }
+
+    /**
+     * @brief Checks whether the option at index I was provided.
+     *
+     * @tparam I Option index.
+     * @return true if the option has a value.
+     */
+    template <std::size_t I>
+    bool has() const {
+        static_assert(I < size, "Option index out of range");
+        return present_[I];
+    }
+
+   private:
+    std::array<OptionType, size> slots_{}; /**< Converted option values. */
+    std::array<bool, size> present_{};     /**< Whether each slot holds a value. */
+
+    /**
+     * @brief Converts each declared option into its slot.
+     */
+    template <std::size_t... I>
+    void load(const Context& ctx, std::index_sequence<I...>) {
+        (load_one<I>(ctx), ...);
+    }
+
+    /**
+     * @brief Converts the option at index I into its slot.
+     */
+    template <std::size_t I>
+    void load_one(const Context& ctx) {
+        using T = type_at<I>;
+        static_assert(is_option_type<T>(), "Schema option type must be one of the OptionType alternatives");
+
+        const std::string_view name = name_at(I);
+        if constexpr (std::is_same_v<T, bool>) {
+            slots_[I].template emplace<T>(ctx.get_option<bool>(name));
+            present_[I] = true;
+        } else {
+            T value{};
+            if (ctx.find_option(name, value)) {
+                slots_[I].template emplace<T>(std::move(value));
+                present_[I] = true;
+            }
+        }
+    }
+};
+
+}  // namespace Clixxi
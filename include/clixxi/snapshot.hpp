@@ -0,0 +1,237 @@
+/**
+ * @file snapshot.hpp
+ * @brief Provides a binary snapshot cache of parsed configuration.
+ *
+ * ConfigSnapshot stores the merged options of a set of configuration files
+ * as a compact binary image: a header, a record array with precomputed key
+ * hashes and one string blob. A later launch maps the image, checks that it
+ * was written for the same files and the same executable, and builds its
+ * option table from views into the mapping, so nothing is parsed or hashed.
+ * Available only on POSIX systems.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+#include <clixxi/option_table.hpp>
+
+#ifdef CLIXXI_HAS_POSIX
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Clixxi {
+
+/**
+ * @class ConfigSnapshot
+ * @brief Memory-mapped, validated image of a merged option table.
+ *
+ * The image is keyed by source_key(), which covers the identity (path, size,
+ * modification time and inode) of every source file and of the running
+ * executable. Any change to those invalidates the snapshot.
+ *
+ * The image uses the native byte order and is meant as a local cache,
+ * not as a portable file format.
+ */
+class ConfigSnapshot {
+   public:
+    ConfigSnapshot() = default;
+    ConfigSnapshot(const ConfigSnapshot&) = delete;
+    ConfigSnapshot& operator=(const ConfigSnapshot&) = delete;
+
+    /** @brief Unmaps the image. */
+    ~ConfigSnapshot() {
+        if (mapping_)
+            ::munmap(mapping_, size_);
+    }
+
+    /**
+     * @brief Computes the validation key of a set of source files.
+     *
+     * @param paths Source file paths in precedence order.
+     * @return Key covering the executable and every source file.
+     */
+    static std::uint64_t source_key(const std::vector<std::string>& paths) {
+        std::uint64_t key = 14695981039346656037ull;
+        mix(key, &format_version, sizeof(format_version));
+#ifdef __linux__
+        mix_file(key, "/proc/self/exe");
+#endif
+        for (const std::string& path : paths) {
+            mix(key, path.data(), path.size() + 1);
+            mix_file(key, path.c_str());
+        }
+        return key;
+    }
+
+    /**
+     * @brief Maps and validates a snapshot image.
+     *
+     * @param path Snapshot file path.
+     * @param key Expected value of source_key().
+     * @return true if the image is valid for key and options() is ready.
+     */
+    bool load(const std::string& path, std::uint64_t key) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            return false;
+        mapping_ = mapping;
+
+        const char* base = static_cast<const char*>(mapping_);
+        Header header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0 || header.version != format_version ||
+            header.key != key || header.count > size_ / sizeof(Record) || header.blob_size > size_ ||
+            size_ != sizeof(Header) + header.count * sizeof(Record) + header.blob_size)
+            return false;
+
+        const char* records = base + sizeof(Header);
+        const char* blob = records + header.count * sizeof(Record);
+        options_.reserve(header.count);
+        for (std::uint64_t i = 0; i < header.count; ++i) {
+            Record record;
+            std::memcpy(&record, records + i * sizeof(Record), sizeof(record));
+            if (std::uint64_t(record.key_offset) + record.key_size > header.blob_size ||
+                std::uint64_t(record.value_offset) + record.value_size > header.blob_size) {
+                options_ = OptionTable();
+                return false;
+            }
+            options_.emplace(std::string_view(blob + record.key_offset, record.key_size),
+                             std::string_view(blob + record.value_offset, record.value_size), record.hash);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Writes a snapshot image atomically (temporary file and rename).
+     *
+     * @param path Snapshot file path.
+     * @param key Value of source_key() for the merged sources.
+     * @param options Merged options to store.
+     * @return true if the image was written.
+     */
+    static bool save(const std::string& path, std::uint64_t key, const OptionTable& options) {
+        std::vector<Record> records;
+        records.reserve(options.size());
+        std::string blob;
+        for (const OptionTable::Entry& entry : options) {
+            Record record{};
+            record.hash = hash_name(entry.key);
+            record.key_offset = static_cast<std::uint32_t>(blob.size());
+            record.key_size = static_cast<std::uint32_t>(entry.key.size());
+            blob.append(entry.key);
+            record.value_offset = static_cast<std::uint32_t>(blob.size());
+            record.value_size = static_cast<std::uint32_t>(entry.value.size());
+            blob.append(entry.value);
+            records.push_back(record);
+        }
+
+        Header header{};
+        std::memcpy(header.magic, magic, sizeof(header.magic));
+        header.version = format_version;
+        header.count = records.size();
+        header.key = key;
+        header.blob_size = blob.size();
+
+        const std::string temp = path + ".tmp." + std::to_string(::getpid());
+        std::FILE* file = std::fopen(temp.c_str(), "wb");
+        if (!file)
+            return false;
+        const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                             std::fwrite(records.data(), sizeof(Record), records.size(), file) == records.size() &&
+                             std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+        if (std::fclose(file) != 0 || !written || std::rename(temp.c_str(), path.c_str()) != 0) {
+            std::remove(temp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /** @brief Returns the options of a loaded snapshot. */
+    const OptionTable& options() const { return options_; }
+
+   private:
+    static constexpr char magic[8] = {'C', 'L', 'X', 'S', 'N', 'A', 'P', '\0'};
+    static constexpr std::uint32_t format_version = 1;
+
+    /**
+     * @struct Header
+     * @brief Fixed-size image header.
+     */
+    struct Header {
+        char magic[8];           /**< Format signature. */
+        std::uint32_t version;   /**< Format version. */
+        std::uint32_t reserved;  /**< Padding (zero). */
+        std::uint64_t key;       /**< source_key() of the sources. */
+        std::uint64_t count;     /**< Number of records. */
+        std::uint64_t blob_size; /**< Size of the string blob. */
+    };
+
+    /**
+     * @struct Record
+     * @brief One stored option; offsets point into the string blob.
+     */
+    struct Record {
+        std::uint32_t hash;         /**< hash_name() of the key. */
+        std::uint32_t key_offset;   /**< Key position in the blob. */
+        std::uint32_t key_size;     /**< Key length. */
+        std::uint32_t value_offset; /**< Value position in the blob. */
+        std::uint32_t value_size;   /**< Value length. */
+    };
+
+    void* mapping_ = nullptr; /**< Mapped image. */
+    std::size_t size_ = 0;    /**< Size of the image. */
+    OptionTable options_;     /**< Table viewing the mapped blob. */
+
+    /** @brief Mixes bytes into an FNV-1a 64-bit hash. */
+    static void mix(std::uint64_t& key, const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            key ^= bytes[i];
+            key *= 1099511628211ull;
+        }
+    }
+
+    /** @brief Mixes the identity of a file (or its absence) into a hash. */
+    static void mix_file(std::uint64_t& key, const char* path) {
+        struct stat info {};
+        if (::stat(path, &info) != 0) {
+            mix(key, "missing", 7);
+            return;
+        }
+#ifdef __APPLE__
+        const auto& modified = info.st_mtimespec;
+#else
+        const auto& modified = info.st_mtim;
+#endif
+        const std::int64_t identity[] = {static_cast<std::int64_t>(info.st_size),
+                                         static_cast<std::int64_t>(info.st_ino),
+                                         static_cast<std::int64_t>(modified.tv_sec),
+                                         static_cast<std::int64_t>(modified.tv_nsec)};
+        mix(key, identity, sizeof(identity));
+    }
+};
+
+}  // namespace Clixxi
+
+#endif
@@ -0,0 +1,354 @@
+/**
+ * @file static_app.hpp
+ * @brief Provides a fully compile-time application definition.
+ *
+ * For tools whose command set is fixed, StaticApp replaces the runtime
+ * registry of App. Commands, their options and handlers are template
+ * arguments: the dispatch table is a fold over precomputed name hashes,
+ * handlers are called directly (no type erasure), and help texts are
+ * rendered into constant arrays at compile time. Nothing is allocated or
+ * constructed before the command runs. StaticApp coexists with App; both
+ * may be used in the same program.
+ */
+
+#pragma once
+
+#include <clixxi/context.hpp>
+#include <clixxi/exception.hpp>
+#include <clixxi/memory.hpp>
+#include <clixxi/option_table.hpp>
+#include <clixxi/output.hpp>
+#include <clixxi/schema.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Clixxi {
+
+namespace detail {
+
+/**
+ * @brief Returns the indices of names in sorted order (App and Command list names sorted).
+ *
+ * @tparam N Number of names.
+ * @param names Names (at least N entries).
+ */
+template <std::size_t N>
+constexpr std::array<std::size_t, N> name_order(const char* const* names) {
+    std::array<std::size_t, N> order{};
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t j = i;
+        for (; j > 0 && std::string_view(names[i]) < std::string_view(names[order[j - 1]]); --j)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+    return order;
+}
+
+}  // namespace detail
+
+/**
+ * @struct cmd
+ * @brief Compile-time command descriptor for StaticApp.
+ *
+ * The handler is a function with signature
+ * `void(const Context&, const Schema<Opts...>&)`, or `void(const Context&)`.
+ *
+ * @tparam Name Command name (pointer to a static constexpr char array).
+ * @tparam Desc Command description (may be nullptr).
+ * @tparam Handler Handler function.
+ * @tparam Opts Option descriptors (see opt).
+ */
+template <const char* Name, const char* Desc, auto Handler, typename... Opts>
+struct cmd {
+    static constexpr const char* name = Name;        /**< Command name. */
+    static constexpr const char* description = Desc; /**< Command description (may be nullptr). */
+    using schema = Schema<Opts...>;                  /**< Typed options of the command. */
+
+    /**
+     * @brief Returns the command help text (rendered at compile time).
+     */
+    static constexpr std::string_view help();
+
+    /**
+     * @brief Renders the command help in the format of Command::get_help().
+     */
+    template <typename W>
+    static constexpr void render_help(W& w) {
+        w.put("Command: ");
+        w.put(Name);
+        w.put("\n");
+        if constexpr (Desc != nullptr) {
+            if (Desc[0] != '\0') {
+                w.put("Description: ");
+                w.put(Desc);
+                w.put("\n\n");
+            }
+        }
+        w.put("Usage: <PROGRAM> ");
+        w.put(Name);
+        if constexpr (sizeof...(Opts) > 0) {
+            w.put(" [OPTIONS]\n\n");
+            w.put("OPTIONS:\n");
+        }
+        constexpr auto order = detail::name_order<sizeof...(Opts)>(option_names);
+        for (std::size_t i = 0; i < sizeof...(Opts); ++i) {
+            const char* name = option_names[order[i]];
+            const char* desc = option_descriptions[order[i]];
+            w.put("  --");
+            w.put(name);
+            w.pad(name, 10);
+            w.put(desc && desc[0] != '\0' ? desc : "No description.");
+            w.put("\n");
+        }
+        w.put("\n");
+    }
+
+    /**
+     * @brief Calls the handler with the parsed context.
+     */
+    static void invoke(const Context& context) {
+        if constexpr (std::is_invocable_v<decltype(Handler), const Context&, const schema&>) {
+            Handler(context, schema(context));
+        } else {
+            static_assert(std::is_invocable_v<decltype(Handler), const Context&>,
+                          "Handler must be callable as void(const Context&, const Schema<Opts...>&) or "
+                          "void(const Context&)");
+            Handler(context);
+        }
+    }
+
+   private:
+    static constexpr const char* option_names[] = {Opts::name..., nullptr};               /**< Option names. */
+    static constexpr const char* option_descriptions[] = {Opts::description..., nullptr}; /**< Option descriptions. */
+};
+
+namespace detail {
+
+/**
+ * @struct TextSize
+ * @brief Constexpr writer that only measures the rendered text.
+ */
+struct TextSize {
+    std::size_t size = 0;
+
+    constexpr void put(std::string_view text) { size += text.size(); }
+
+    constexpr void pad(std::string_view text, std::size_t width) {
+        if (text.size() < width)
+            size += width - text.size();
+    }
+};
+
+/**
+ * @struct TextBuffer
+ * @brief Constexpr writer filling a fixed-size character array.
+ */
+template <std::size_t N>
+struct TextBuffer {
+    std::array<char, N + 1> data{};
+    std::size_t size = 0;
+
+    constexpr void put(std::string_view text) {
+        for (char c : text)
+            data[size++] = c;
+    }
+
+    constexpr void pad(std::string_view text, std::size_t width) {
+        for (std::size_t i = text.size(); i < width; ++i)
+            data[size++] = ' ';
+    }
+
+    constexpr std::string_view view() const { return std::string_view(data.data(), size); }
+};
+
+/**
+ * @brief Measures the text written by Renderer::render_help().
+ */
+template <typename Renderer>
+constexpr std::size_t text_size() {
+    TextSize counter;
+    Renderer::render_help(counter);
+    return counter.size;
+}
+
+/**
+ * @brief Renders the text of Renderer::render_help() into a constant buffer.
+ */
+template <typename Renderer>
+constexpr TextBuffer<text_size<Renderer>()> render_text() {
+    TextBuffer<text_size<Renderer>()> buffer;
+    Renderer::render_help(buffer);
+    return buffer;
+}
+
+/**
+ * @brief Help text of Renderer, rendered once at compile time.
+ */
+template <typename Renderer>
+inline constexpr auto help_text = render_text<Renderer>();
+
+/**
+ * @struct AppHelp
+ * @brief Renders the help of a StaticApp in the format of App::get_help().
+ */
+template <const char* Name, const char* Desc, typename... Cmds>
+struct AppHelp {
+    template <typename W>
+    static constexpr void render_help(W& w) {
+        w.put(Name);
+        if constexpr (Desc != nullptr) {
+            if (Desc[0] != '\0') {
+                w.put(" - ");
+                w.put(Desc);
+                w.put("\n");
+            }
+        }
+        w.put("\n");
+        w.put("Usage: ");
+        w.put(Name);
+        w.put(" <COMMAND> [OPTIONS]\n\n");
+        w.put("AVAILABLE COMMANDS:\n");
+        constexpr auto order = name_order<sizeof...(Cmds)>(names);
+        for (std::size_t i = 0; i < sizeof...(Cmds); ++i) {
+            const char* name = names[order[i]];
+            const char* desc = descriptions[order[i]];
+            w.put("  ");
+            w.put(name);
+            w.pad(name, 12);
+            w.put(desc && desc[0] != '\0' ? desc : "no description");
+            w.put("\n");
+        }
+        w.put("\nSee '");
+        w.put(Name);
+        w.put(" <COMMAND> --help' to read about command.\n\n");
+        w.put("This application created by Clixxi (https://github.com/asyqew/clixxi).\n");
+    }
+
+   private:
+    static constexpr const char* names[] = {Cmds::name..., nullptr};               /**< Command names. */
+    static constexpr const char* descriptions[] = {Cmds::description..., nullptr}; /**< Command descriptions. */
+};
+
+}  // namespace detail
+
+template <const char* Name, const char* Desc, auto Handler, typename... Opts>
+constexpr std::string_view cmd<Name, Desc, Handler, Opts...>::help() {
+    return detail::help_text<cmd>.view();
+}
+
+/**
+ * @class StaticApp
+ * @brief Application whose commands are fixed at compile time.
+ *
+ * Example:
+ * @code
+ * static constexpr char app_name[] = "calc";
+ * static constexpr char sum_name[] = "sum", a[] = "a", b[] = "b";
+ * using SumOptions = Clixxi::Schema<Clixxi::opt<a, int>, Clixxi::opt<b, int>>;
+ *
+ * void sum(const Clixxi::Context& ctx, const SumOptions& opts) { ctx.out() << opts.get<a>() + opts.get<b>() << '\n'; }
+ *
+ * using Calc = Clixxi::StaticApp<app_name, nullptr, nullptr,
+ *                                Clixxi::cmd<sum_name, nullptr, sum, Clixxi::opt<a, int>, Clixxi::opt<b, int>>>;
+ *
+ * int main(int argc, char* argv[]) { Calc::run(argc, argv); }
+ * @endcode
+ *
+ * Built-in "help" and "version" and the per-command "--help" behave as in
+ * App, and the help texts are identical. Each invocation parses into a
+ * stack Arena.
+ *
+ * @tparam Name Application name.
+ * @tparam Desc Application description (may be nullptr).
+ * @tparam Version Application version (nullptr for "1.0").
+ * @tparam Cmds Command descriptors (see cmd).
+ */
+template <const char* Name, const char* Desc, const char* Version, typename... Cmds>
+class StaticApp {
+   public:
+    /** @brief Number of commands. */
+    static constexpr std::size_t size = sizeof...(Cmds);
+
+    /**
+     * @brief Returns the application help text (rendered at compile time).
+     */
+    static constexpr std::string_view help() { return detail::help_text<detail::AppHelp<Name, Desc, Cmds...>>.view(); }
+
+    /**
+     * @brief Runs the application (same semantics as App::run()).
+     *
+     * @throws `CommandNotFoundException` - If command is not declared.
+     */
+    static void run(int argc, char* argv[]) {
+        if (argc <= 1) {
+            print(help());
+            return;
+        }
+        dispatch(argc - 1, argv + 1);
+    }
+
+    /**
+     * @brief Dispatches a single invocation without the program name.
+     *
+     * @param argc Number of entries in argv.
+     * @param argv Command name followed by its arguments.
+     *
+     * @throws `CommandNotFoundException` - If command is not declared.
+     */
+    static void dispatch(int argc, const char* const* argv) {
+        if (argc <= 0 || std::string_view(argv[0]) == "help") {
+            print(help());
+            return;
+        }
+
+        const std::string_view name = argv[0];
+        if (name == "version") {
+            Output& out = Output::current().write(Name).write(" version ");
+            if constexpr (Version != nullptr)
+                out.write(Version);
+            else
+                out.write("1.0");
+            out.flush();
+            return;
+        }
+
+        [[maybe_unused]] const std::uint32_t hash = hash_name(name);
+        const bool found = (try_command<Cmds>(name, hash, argc, argv) || ...);
+        if (!found)
+            throw CommandNotFoundException(std::string(name));
+    }
+
+   private:
+    /** @brief Writes text to the current output sink and flushes it. */
+    static void print(std::string_view text) { Output::current().write(text).flush(); }
+
+    /**
+     * @brief Executes command C if it matches the name.
+     *
+     * @return true if C matched.
+     */
+    template <typename C>
+    static bool try_command(std::string_view name, std::uint32_t hash, int argc, const char* const* argv) {
+        static constexpr std::uint32_t command_hash = hash_name(C::name);
+        if (hash != command_hash || name != C::name)
+            return false;
+
+        Arena<4096> arena;
+        const Context context(argc - 1, argv + 1, arena.resource());
+        if (context.has_option("help")) {
+            print(C::help());
+            return true;
+        }
+        struct FlushOnExit {
+            ~FlushOnExit() { Output::current().flush(); }
+        } flush_on_exit;
+        C::invoke(context);
+        return true;
+    }
+};
+
+}  // namespace Clixxi
@@ -0,0 +1,162 @@
+/**
+ * @file stats.hpp
+ * @brief Provides optional counters of framework work (allocations, exceptions, lookups, conversions).
+ *
+ * Counting is compiled in only when CLIXXI_STATS is defined; otherwise the
+ * CLIXXI_STAT macros expand to nothing and every counter stays zero, so code
+ * reading Stats compiles either way. Counters are thread-local. App copies
+ * the counts of each traced dispatch into DispatchTimings::stats, so
+ * after_dispatch() hooks can report them per command.
+ *
+ * Heap allocations are counted only in a program that also expands
+ * CLIXXI_STATS_ALLOCATION_HOOKS in exactly one source file; the hooks
+ * replace the global operator new and count allocations made while
+ * framework code (not a handler) is running.
+ */
+
+#pragma once
+
+#include <clixxi/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace Clixxi {
+
+/**
+ * @struct Stats
+ * @brief Counters of work done by framework code.
+ */
+struct Stats {
+#ifdef CLIXXI_STATS
+    static constexpr bool enabled = true; /**< Whether counting is compiled in. */
+#else
+    static constexpr bool enabled = false; /**< Whether counting is compiled in. */
+#endif
+
+    std::uint64_t allocations = 0;       /**< Heap allocations by framework code (needs allocation hooks). */
+    std::uint64_t exceptions_thrown = 0; /**< Clixxi exceptions constructed for throwing. */
+    std::uint64_t exceptions_caught = 0; /**< Clixxi exceptions caught and handled inside the framework. */
+    std::uint64_t command_lookups = 0;   /**< Command name resolutions. */
+    std::uint64_t option_lookups = 0;    /**< Option table probes (arguments and each layered source). */
+    std::uint64_t conversions = 0;       /**< Value conversions (cache misses). */
+    std::uint64_t cache_hits = 0;        /**< Conversions answered from the entry cache. */
+
+    /** @brief Returns the counts accumulated since an earlier snapshot. */
+    Stats operator-(const Stats& earlier) const {
+        Stats delta;
+        delta.allocations = allocations - earlier.allocations;
+        delta.exceptions_thrown = exceptions_thrown - earlier.exceptions_thrown;
+        delta.exceptions_caught = exceptions_caught - earlier.exceptions_caught;
+        delta.command_lookups = command_lookups - earlier.command_lookups;
+        delta.option_lookups = option_lookups - earlier.option_lookups;
+        delta.conversions = conversions - earlier.conversions;
+        delta.cache_hits = cache_hits - earlier.cache_hits;
+        return delta;
+    }
+
+    /**
+     * @brief Returns the counters of the calling thread.
+     */
+    static Stats& local() {
+        thread_local Stats stats;
+        return stats;
+    }
+
+    /**
+     * @brief Returns whether the calling thread is running framework code.
+     *
+     * Set by StatsScope; used to attribute heap allocations.
+     */
+    static bool& in_framework() {
+        thread_local bool framework = false;
+        return framework;
+    }
+};
+
+/**
+ * @class StatsScope
+ * @brief Marks a scope as framework code (or as handler code) for allocation counting.
+ */
+class StatsScope {
+   public:
+    /**
+     * @param framework true for framework code, false for user handler code.
+     */
+    explicit StatsScope(bool framework) : saved_(std::exchange(Stats::in_framework(), framework)) {}
+
+    StatsScope(const StatsScope&) = delete;
+    StatsScope& operator=(const StatsScope&) = delete;
+
+    ~StatsScope() { Stats::in_framework() = saved_; }
+
+   private:
+    bool saved_; /**< Previous state, restored on exit. */
+};
+
+namespace detail {
+
+#if defined(__GNUC__)
+#define CLIXXI_STATS_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define CLIXXI_STATS_NOINLINE __declspec(noinline)
+#else
+#define CLIXXI_STATS_NOINLINE
+#endif
+
+/** @brief Allocation behind CLIXXI_STATS_ALLOCATION_HOOKS: counts framework allocations. */
+CLIXXI_STATS_NOINLINE inline void* counted_allocate(std::size_t size) {
+    if (Stats::in_framework())
+        ++Stats::local().allocations;
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+/**
+ * @brief Release behind CLIXXI_STATS_ALLOCATION_HOOKS.
+ *
+ * Not inlined, so that compilers do not pair the malloc() inside with the
+ * replaced operator new and report a mismatched deallocation.
+ */
+CLIXXI_STATS_NOINLINE inline void counted_release(void* memory) noexcept { std::free(memory); }
+
+}  // namespace detail
+
+}  // namespace Clixxi
+
+/**
+ * @def CLIXXI_STAT
+ * @brief Increments a Stats counter of the calling thread (no-op without CLIXXI_STATS).
+ *
+ * @def CLIXXI_STATS_SCOPE
+ * @brief Marks the rest of the enclosing block as framework (true) or handler (false) code.
+ */
+#ifdef CLIXXI_STATS
+#define CLIXXI_STAT(counter) (++::Clixxi::Stats::local().counter)
+#define CLIXXI_STAT_ADD(counter, n) (::Clixxi::Stats::local().counter += (n))
+#define CLIXXI_STATS_SCOPE(framework) const ::Clixxi::StatsScope clixxi_stats_scope_(framework)
+#else
+#define CLIXXI_STAT(counter) ((void)0)
+#define CLIXXI_STAT_ADD(counter, n) ((void)0)
+#define CLIXXI_STATS_SCOPE(framework) ((void)0)
+#endif
+
+/**
+ * @def CLIXXI_STATS_ALLOCATION_HOOKS
+ * @brief Replaces the global operator new/delete with counting versions.
+ *
+ * Expand once, at namespace scope, in one source file of the program:
+ * @code
+ * #define CLIXXI_STATS 1
+ * #include <clixxi/app.hpp>
+ * CLIXXI_STATS_ALLOCATION_HOOKS
+ * @endcode
+ */
+#define CLIXXI_STATS_ALLOCATION_HOOKS                                                                        \
+    void* operator new(std::size_t size) { return ::Clixxi::detail::counted_allocate(size); }             \
+    void operator delete(void* memory) noexcept { ::Clixxi::detail::counted_release(memory); }           \
+    void operator delete(void* memory, std::size_t) noexcept { ::Clixxi::detail::counted_release(memory); }
@@ -0,0 +1,160 @@
+/**
+ * @file tokenizer.hpp
+ * @brief Splits command lines into arguments using shell-like quoting rules.
+ *
+ * CommandLine turns a single line of text into an argc/argv pair that can be
+ * passed straight to App::dispatch() and Context. Storage is reused between
+ * lines, so a long-running REPL does not allocate per command once warm.
+ * Runs of ordinary bytes are located with find_any() and copied in bulk.
+ */
+
+#pragma once
+
+#include <clixxi/scan.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Clixxi {
+
+/**
+ * @class CommandLine
+ * @brief Reusable tokenizer producing a null-terminated argv vector.
+ *
+ * Supported syntax:
+ * - arguments are separated by spaces, tabs and carriage returns;
+ * - `'text'` keeps text literally;
+ * - `"text"` keeps text, with `\"`, `\\`, `\$` and `` \` `` escapes;
+ * - `\c` outside quotes escapes any character;
+ * - `#` at the start of an argument begins a comment.
+ *
+ * Example:
+ * @code
+ * Clixxi::CommandLine line;
+ * line.parse("greet --name 'John Doe'");
+ * app.dispatch(line.argc(), line.argv());
+ * @endcode
+ */
+class CommandLine {
+   public:
+    /**
+     * @brief Tokenizes a line, replacing the previous contents.
+     *
+     * @param line Line of text (without the trailing newline).
+     * @return false if the line ends inside a quoted string or after a lone backslash.
+     */
+    bool parse(std::string_view line) {
+        buffer_.clear();
+        offsets_.clear();
+        argv_.clear();
+
+        enum class State { Space, Word, Single, Double };
+        State state = State::Space;
+
+        const char* p = line.data();
+        const char* const end = p + line.size();
+
+        while (p != end) {
+            switch (state) {
+                case State::Space:
+                    if (*p == ' ' || *p == '\t' || *p == '\r') {
+                        ++p;
+                        break;
+                    }
+                    if (*p == '#')
+                        return finish(true);
+                    offsets_.push_back(buffer_.size());
+                    state = State::Word;
+                    break;
+                case State::Word: {
+                    const char* special = find_any<' ', '\t', '\r', '\'', '"', '\\'>(p, end);
+                    buffer_.append(p, special);
+                    p = special;
+                    if (p == end)
+                        break;
+                    const char c = *p++;
+                    if (c == '\'') {
+                        state = State::Single;
+                    } else if (c == '"') {
+                        state = State::Double;
+                    } else if (c == '\\') {
+                        if (p == end)
+                            return finish(false);
+                        buffer_.push_back(*p++);
+                    } else {
+                        buffer_.push_back('\0');
+                        state = State::Space;
+                    }
+                    break;
+                }
+                case State::Single: {
+                    const char* quote = find_any<'\''>(p, end);
+                    buffer_.append(p, quote);
+                    p = quote;
+                    if (p != end) {
+                        ++p;
+                        state = State::Word;
+                    }
+                    break;
+                }
+                case State::Double: {
+                    const char* special = find_any<'"', '\\'>(p, end);
+                    buffer_.append(p, special);
+                    p = special;
+                    if (p == end)
+                        break;
+                    if (*p == '"') {
+                        ++p;
+                        state = State::Word;
+                    } else if (p + 1 != end && (p[1] == '"' || p[1] == '\\' || p[1] == '$' || p[1] == '`')) {
+                        buffer_.push_back(p[1]);
+                        p += 2;
+                    } else {
+                        buffer_.push_back(*p++);
+                    }
+                    break;
+                }
+            }
+        }
+
+        if (state == State::Word)
+            buffer_.push_back('\0');
+        return finish(state == State::Space || state == State::Word);
+    }
+
+    /** @brief Returns the number of parsed arguments. */
+    int argc() const { return static_cast<int>(offsets_.size()); }
+
+    /** @brief Returns the parsed arguments (null-terminated pointer array). */
+    const char* const* argv() const { return argv_.data(); }
+
+    /** @brief Returns true if the line contained no arguments. */
+    bool empty() const { return offsets_.empty(); }
+
+   private:
+    std::string buffer_;               /**< Unescaped arguments separated by '\0'. */
+    std::vector<std::size_t> offsets_; /**< Start offset of each argument in buffer_. */
+    std::vector<const char*> argv_;    /**< Pointers into buffer_, followed by nullptr. */
+
+    /**
+     * @brief Builds argv_ from the collected offsets.
+     *
+     * @param ok Result to return.
+     * @return ok.
+     */
+    bool finish(bool ok) {
+        if (!ok) {
+            buffer_.clear();
+            offsets_.clear();
+        }
+        argv_.reserve(offsets_.size() + 1);
+        for (std::size_t offset : offsets_)
+            argv_.push_back(buffer_.data() + offset);
+        argv_.push_back(nullptr);
+        return ok;
+    }
+};
+
+}  // namespace Clixxi
@@ -0,0 +1,303 @@
+/**
+ * @file trace.hpp
+ * @brief Provides per-phase timing of command dispatch.
+ *
+ * When tracing is enabled (App::trace(), the `--clixxi-trace` flag or the
+ * CLIXXI_TRACE environment variable) or a dispatch hook is registered, App
+ * records a DispatchTimings for every invocation: argument extraction,
+ * command lookup, Context construction, option conversion, handler
+ * execution and output flush. Timings can be printed as a summary or
+ * written to a Chrome trace file (chrome://tracing, Perfetto).
+ *
+ * While disabled, the cost is one flag check per dispatch and one
+ * thread-local pointer check per option conversion and per flush.
+ */
+
+#pragma once
+
+#include <clixxi/stats.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace Clixxi {
+
+/**
+ * @enum Phase
+ * @brief Measured phases of a dispatch, in execution order.
+ */
+enum class Phase : std::size_t {
+    Extract, /**< Splitting argv and removing framework flags. */
+    Lookup,  /**< Resolving the command (and building a lazy one). */
+    Context, /**< Parsing arguments and layering option sources. */
+    Handler, /**< Running the handler, including option conversion. */
+    Flush,   /**< Writing buffered output. */
+};
+
+/** @brief Number of Phase values. */
+inline constexpr std::size_t phase_count = 5;
+
+/**
+ * @brief Returns the display name of a phase.
+ */
+inline const char* phase_name(Phase phase) {
+    static constexpr const char* names[phase_count] = {"extract", "lookup", "context", "handler", "flush"};
+    return names[static_cast<std::size_t>(phase)];
+}
+
+/**
+ * @struct DispatchTimings
+ * @brief Timings of one dispatched invocation.
+ *
+ * Phase start times are offsets from start. Option conversion happens
+ * inside the handler, so convert is part of the handler duration.
+ */
+struct DispatchTimings {
+    using Clock = std::chrono::steady_clock;   /**< Clock used for all timestamps. */
+    using Duration = std::chrono::nanoseconds; /**< Resolution of all durations. */
+
+    std::string_view command;                     /**< Command path, e.g. "remote add" (valid during the hook call). */
+    Clock::time_point start;                      /**< Start of the dispatch. */
+    std::array<Duration, phase_count> begin{};    /**< Start of each phase, relative to start. */
+    std::array<Duration, phase_count> duration{}; /**< Duration of each phase (zero if skipped). */
+    Duration convert{};                           /**< Time spent in get_option() conversions. */
+    std::size_t conversions = 0;                  /**< Number of get_option() calls. */
+    Stats stats;                                  /**< Framework work counters (zero without CLIXXI_STATS). */
+
+    /** @brief Returns the duration of a phase. */
+    Duration operator[](Phase phase) const { return duration[static_cast<std::size_t>(phase)]; }
+
+    /** @brief Returns the total dispatch time. */
+    Duration total() const {
+        Duration sum{};
+        for (Duration d : duration)
+            sum += d;
+        return sum;
+    }
+
+    /** @brief Returns the framework overhead: everything except handler code (conversion counts as framework). */
+    Duration overhead() const { return total() - (*this)[Phase::Handler] + convert; }
+
+    /**
+     * @brief Records a phase that started at from and ends now.
+     *
+     * @return The current time (start of the next phase).
+     */
+    Clock::time_point record(Phase phase, Clock::time_point from) {
+        const Clock::time_point now = Clock::now();
+        const std::size_t i = static_cast<std::size_t>(phase);
+        begin[i] = std::chrono::duration_cast<Duration>(from - start);
+        duration[i] = std::chrono::duration_cast<Duration>(now - from);
+        return now;
+    }
+
+    /**
+     * @brief Returns the timings of the dispatch running on this thread.
+     *
+     * @return Reference to a thread-local pointer (nullptr while not tracing).
+     */
+    static DispatchTimings*& active() {
+        thread_local DispatchTimings* timings = nullptr;
+        return timings;
+    }
+};
+
+/**
+ * @class ConversionTimer
+ * @brief Adds the lifetime of a scope to the conversion time of the active dispatch.
+ *
+ * Does nothing while no dispatch is traced on this thread.
+ */
+class ConversionTimer {
+   public:
+    ConversionTimer() : timings_(DispatchTimings::active()) {
+        if (timings_)
+            start_ = DispatchTimings::Clock::now();
+    }
+
+    ConversionTimer(const ConversionTimer&) = delete;
+    ConversionTimer& operator=(const ConversionTimer&) = delete;
+
+    ~ConversionTimer() {
+        if (timings_) {
+            timings_->convert += DispatchTimings::Clock::now() - start_;
+            ++timings_->conversions;
+        }
+    }
+
+   private:
+    DispatchTimings* timings_;                 /**< Active timings (nullptr if not tracing). */
+    DispatchTimings::Clock::time_point start_; /**< Start of the scope. */
+};
+
+/**
+ * @enum TraceFormat
+ * @brief Output of the built-in trace.
+ */
+enum class TraceFormat {
+    None,    /**< Tracing disabled. */
+    Summary, /**< Human-readable table on stderr after each dispatch. */
+    Chrome,  /**< Chrome trace events written to a JSON file (truncated once per process). */
+};
+
+/**
+ * @class TraceWriter
+ * @brief Writes DispatchTimings as a summary or as Chrome trace events.
+ */
+class TraceWriter {
+   public:
+    TraceWriter() = default;
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    ~TraceWriter() { close(); }
+
+    /**
+     * @brief Parses a trace specification (flag or environment value).
+     *
+     * Accepted values: empty, "1", "on" or "summary" for a summary;
+     * "chrome:PATH" or a PATH ending in ".json" for a Chrome trace;
+     * "0" or "off" to disable.
+     *
+     * @param spec Specification.
+     * @param path Set to the trace file path for TraceFormat::Chrome.
+     * @return Requested format.
+     */
+    static TraceFormat parse_spec(std::string_view spec, std::string& path) {
+        if (spec == "0" || spec == "off")
+            return TraceFormat::None;
+        if (spec.substr(0, 7) == "chrome:") {
+            path = std::string(spec.substr(7));
+            return TraceFormat::Chrome;
+        }
+        if (spec.size() > 5 && spec.substr(spec.size() - 5) == ".json") {
+            path = std::string(spec);
+            return TraceFormat::Chrome;
+        }
+        return TraceFormat::Summary;
+    }
+
+    /**
+     * @brief Selects the output format.
+     *
+     * @param format Output format.
+     * @param path Chrome trace file path (created or truncated on the first write).
+     */
+    void configure(TraceFormat format, const std::string& path = "") {
+        close();
+        format_ = format;
+        path_ = path;
+    }
+
+    /** @brief Returns the configured format. */
+    TraceFormat format() const { return format_; }
+
+    /**
+     * @brief Writes the timings of one dispatch.
+     *
+     * @param timings Completed timings.
+     */
+    void write(const DispatchTimings& timings) {
+        if (format_ == TraceFormat::Summary)
+            write_summary(stderr, timings);
+        else if (format_ == TraceFormat::Chrome)
+            write_chrome(timings);
+    }
+
+    /**
+     * @brief Writes a human-readable table of the timings.
+     *
+     * @param file Destination.
+     * @param timings Completed timings.
+     */
+    static void write_summary(std::FILE* file, const DispatchTimings& timings) {
+        std::fprintf(file, "clixxi-trace: %.*s\n", static_cast<int>(timings.command.size()), timings.command.data());
+        for (std::size_t i = 0; i < phase_count; ++i) {
+            std::fprintf(file, "  %-9s %10.3f us\n", phase_name(static_cast<Phase>(i)), micros(timings.duration[i]));
+            if (static_cast<Phase>(i) == Phase::Handler && timings.conversions > 0)
+                std::fprintf(file, "    convert %10.3f us (%zu calls)\n", micros(timings.convert), timings.conversions);
+        }
+        std::fprintf(file, "  %-9s %10.3f us\n", "total", micros(timings.total()));
+        std::fprintf(file, "  %-9s %10.3f us\n", "overhead", micros(timings.overhead()));
+        if (Stats::enabled) {
+            const Stats& s = timings.stats;
+            std::fprintf(file,
+                         "  stats     %llu allocations, %llu/%llu exceptions thrown/caught, %llu command and %llu "
+                         "option lookups, %llu conversions, %llu cache hits\n",
+                         ull(s.allocations), ull(s.exceptions_thrown), ull(s.exceptions_caught),
+                         ull(s.command_lookups), ull(s.option_lookups), ull(s.conversions), ull(s.cache_hits));
+        }
+    }
+
+   private:
+    TraceFormat format_ = TraceFormat::None; /**< Output format. */
+    std::string path_;                       /**< Chrome trace file path. */
+    std::FILE* file_ = nullptr;              /**< Open Chrome trace file. */
+    bool first_event_ = true;                /**< Whether no event was written yet. */
+
+    static double micros(DispatchTimings::Duration d) { return static_cast<double>(d.count()) / 1000.0; }
+
+    static unsigned long long ull(std::uint64_t n) { return static_cast<unsigned long long>(n); }
+
+    /**
+     * @brief Appends complete ("X") events for every measured phase.
+     *
+     * The file stays open so that events of later dispatches (for example
+     * in serve()) are appended; the JSON array is closed with the writer.
+     * Trace viewers also accept the unterminated array of a killed process.
+     */
+    void write_chrome(const DispatchTimings& timings) {
+        if (!file_) {
+            file_ = std::fopen(path_.c_str(), "w");
+            if (!file_)
+                return;
+            std::fputs("[\n", file_);
+            first_event_ = true;
+        }
+        const double base = micros(std::chrono::duration_cast<DispatchTimings::Duration>(
+            timings.start.time_since_epoch()));
+        for (std::size_t i = 0; i < phase_count; ++i) {
+            if (timings.duration[i].count() == 0 && static_cast<Phase>(i) != Phase::Handler)
+                continue;
+            std::fprintf(file_,
+                         "%s{\"name\":\"%s\",\"cat\":\"clixxi\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                         "\"pid\":1,\"tid\":1,\"args\":{\"command\":\"",
+                         first_event_ ? "" : ",\n", phase_name(static_cast<Phase>(i)),
+                         base + micros(timings.begin[i]), micros(timings.duration[i]));
+            write_escaped(timings.command);
+            if (static_cast<Phase>(i) == Phase::Handler)
+                std::fprintf(file_, "\",\"convert_us\":%.3f,\"conversions\":%zu}}", micros(timings.convert),
+                             timings.conversions);
+            else
+                std::fputs("\"}}", file_);
+            first_event_ = false;
+        }
+        std::fflush(file_);
+    }
+
+    /** @brief Writes a JSON string body. */
+    void write_escaped(std::string_view text) {
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                std::fputc('\\', file_);
+            if (static_cast<unsigned char>(c) >= 0x20)
+                std::fputc(c, file_);
+        }
+    }
+
+    /** @brief Closes the Chrome trace file. */
+    void close() {
+        if (file_) {
+            std::fputs("\n]\n", file_);
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+    }
+};
+
+}  // namespace Clixxi